@@ -0,0 +1,277 @@
+// 多引擎吞吐量对比：Occ / Occ-Eager / Ww / Ring / NOrec
+//
+// 用法: bench_engines [每线程事务数] [最大线程数]
+// 结果打印到 stderr。
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "OccSTM/STM.hpp"
+#include "OccSTM/HotTMVar.hpp"
+#include "OccSTM/TMVarArena.hpp"
+#include "RingSTM/STM.hpp"
+#include "NOrecSTM/STM.hpp"
+#include "WwSTM/TxContext.hpp"
+#include "WwSTM/TMVar.hpp"
+
+namespace {
+
+// ================= 引擎适配层 =================
+// 每个引擎提供 Var<T> 与 run(f)，f 接收一个带 load/store 的事务对象
+
+struct OccEngine {
+    static constexpr const char* kName = "Occ";
+
+    template<typename T>
+    using Var = STM::Var<T>;
+
+    template<typename F>
+    static void run(F&& f) {
+        STM::atomically([&](STM::Occ::Transaction& tx) { f(tx); });
+    }
+};
+
+struct OccEagerEngine {
+    static constexpr const char* kName = "Eager";
+
+    template<typename T>
+    using Var = STM::Var<T, STM::Occ::EagerPolicy>;
+
+    template<typename F>
+    static void run(F&& f) {
+        STM::atomically<STM::Occ::EagerPolicy>(
+            [&](STM::Occ::BasicTransaction<STM::Occ::EagerPolicy>& tx) { f(tx); });
+    }
+};
+
+struct RingEngine {
+    static constexpr const char* kName = "Ring";
+
+    template<typename T>
+    using Var = STM::Ring::TMVar<T>;
+
+    template<typename F>
+    static void run(F&& f) {
+        STM::Ring::atomically([&](STM::Ring::Transaction& tx) { f(tx); });
+    }
+};
+
+struct NOrecEngine {
+    static constexpr const char* kName = "NOrec";
+
+    template<typename T>
+    using Var = STM::NOrec::Var<T>;
+
+    template<typename F>
+    static void run(F&& f) {
+        STM::NOrec::atomically([&](STM::NOrec::Transaction& tx) { f(tx); });
+    }
+};
+
+struct WwEngine {
+    static constexpr const char* kName = "Ww";
+
+    template<typename T>
+    using Var = STM::Ww::TMVar<T>;
+
+    // 把 read/write 接口包装成 load/store
+    struct Tx {
+        STM::Ww::TxContext& ctx;
+
+        template<typename T>
+        T load(Var<T>& var) { return ctx.read(var); }
+
+        template<typename T>
+        void store(Var<T>& var, const T& val) { ctx.write(var, val); }
+    };
+
+    template<typename F>
+    static void run(F&& f) {
+        static thread_local STM::Ww::TxContext ctx;
+        while (true) {
+            ctx.begin();
+            Tx tx{ctx};
+            f(tx);
+            if (ctx.commit()) return;
+            std::this_thread::yield();
+        }
+    }
+};
+
+
+// ================= 负载 =================
+
+template<typename Body>
+double timeThreads(int threads, Body&& body) {
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() { body(t); });
+    }
+    for (auto& w : workers) w.join();
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+// 所有线程争用同一个计数器
+template<typename E>
+double counterWorkload(int threads, int ops) {
+    typename E::template Var<long> counter(0L);
+
+    return timeThreads(threads, [&](int) {
+        for (int i = 0; i < ops; ++i) {
+            E::run([&](auto& tx) {
+                tx.store(counter, tx.load(counter) + 1);
+            });
+        }
+    });
+}
+
+// 大读集、稀少写入：每个事务读 32 个变量，每 16 个事务写一次
+template<typename E>
+double readMostlyWorkload(int threads, int ops) {
+    using Var = typename E::template Var<long>;
+    constexpr int kVars = 256;
+    constexpr int kReads = 32;
+
+    std::vector<std::unique_ptr<Var>> vars;
+    for (int i = 0; i < kVars; ++i) vars.push_back(std::make_unique<Var>(1L));
+
+    return timeThreads(threads, [&](int t) {
+        unsigned seed = 2654435761u * static_cast<unsigned>(t + 1);
+        for (int i = 0; i < ops; ++i) {
+            seed = seed * 1103515245u + 12345u;
+            unsigned base = seed >> 8;
+            bool writer = (i % 16) == 0;
+
+            E::run([&](auto& tx) {
+                long sum = 0;
+                for (int k = 0; k < kReads; ++k) {
+                    sum += tx.load(*vars[(base + k * 7) % kVars]);
+                }
+                if (writer) {
+                    Var& target = *vars[base % kVars];
+                    tx.store(target, tx.load(target) + (sum & 1));
+                }
+            });
+        }
+    });
+}
+
+// 互不相交：每个线程只更新自己的变量
+template<typename E>
+double disjointWorkload(int threads, int ops) {
+    using Var = typename E::template Var<long>;
+
+    std::vector<std::unique_ptr<Var>> vars;
+    for (int i = 0; i < threads; ++i) vars.push_back(std::make_unique<Var>(0L));
+
+    return timeThreads(threads, [&](int t) {
+        Var& mine = *vars[t];
+        for (int i = 0; i < ops; ++i) {
+            E::run([&](auto& tx) {
+                tx.store(mine, tx.load(mine) + 1);
+            });
+        }
+    });
+}
+
+
+// 与 counter 相同的负载，改用 Occ 的单变量快路径 var.atomicUpdate
+template<typename Policy>
+double atomicUpdateCounter(int threads, int ops) {
+    STM::Var<long, Policy> counter(0L);
+
+    return timeThreads(threads, [&](int) {
+        for (int i = 0; i < ops; ++i) {
+            counter.atomicUpdate([](const long& v) { return v + 1; });
+        }
+    });
+}
+
+// 同上，改用热点变量的平面合并通道 hot.update
+template<typename Policy>
+double hotCounter(int threads, int ops) {
+    STM::Occ::HotTMVar<long, Policy> counter(0L);
+
+    return timeThreads(threads, [&](int) {
+        for (int i = 0; i < ops; ++i) {
+            counter.update([](const long& v) { return v + 1; });
+        }
+    });
+}
+
+// 冷启动：逐个 new TMVar 与 TMVarArena 批量构造的对比，返回每秒构造的变量数 (百万)
+template<bool Bulk>
+double coldStart(int count) {
+    auto start = std::chrono::steady_clock::now();
+
+    if constexpr (Bulk) {
+        STM::Occ::TMVarArena<long> arena(count, [](size_t i) { return static_cast<long>(i); });
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return count / elapsed.count() / 1e6;
+    }
+    else {
+        std::vector<STM::Var<long>*> vars;
+        vars.reserve(count);
+        for (int i = 0; i < count; ++i) vars.push_back(new STM::Var<long>(static_cast<long>(i)));
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        for (auto* v : vars) delete v;
+        return count / elapsed.count() / 1e6;
+    }
+}
+
+template<typename E>
+void runEngine(const char* workload, double (*fn)(int, int), int threads, int ops) {
+    double seconds = fn(threads, ops);
+    double mops = static_cast<double>(threads) * ops / seconds / 1e6;
+    std::fprintf(stderr, "%-12s %7d %-6s %10.3f\n", workload, threads, E::kName, mops);
+}
+
+template<template<typename> class W>
+void runWorkload(const char* name, int max_threads, int ops) {
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+        runEngine<OccEngine>(name, &W<OccEngine>::run, threads, ops);
+        runEngine<OccEagerEngine>(name, &W<OccEagerEngine>::run, threads, ops);
+        runEngine<WwEngine>(name, &W<WwEngine>::run, threads, ops);
+        runEngine<RingEngine>(name, &W<RingEngine>::run, threads, ops);
+        runEngine<NOrecEngine>(name, &W<NOrecEngine>::run, threads, ops);
+    }
+}
+
+template<typename E> struct Counter    { static double run(int t, int n) { return counterWorkload<E>(t, n); } };
+template<typename E> struct ReadMostly { static double run(int t, int n) { return readMostlyWorkload<E>(t, n); } };
+template<typename E> struct Disjoint   { static double run(int t, int n) { return disjointWorkload<E>(t, n); } };
+
+} // namespace
+
+
+int main(int argc, char** argv) {
+    int ops = argc > 1 ? std::atoi(argv[1]) : 20000;
+    int max_threads = argc > 2 ? std::atoi(argv[2]) : 8;
+
+    std::fprintf(stderr, "%-12s %7s %-6s %10s\n", "workload", "threads", "engine", "Mtx/s");
+
+    runWorkload<Counter>("counter", max_threads, ops);
+    runWorkload<ReadMostly>("read-mostly", max_threads, ops);
+    runWorkload<Disjoint>("disjoint", max_threads, ops);
+
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+        runEngine<OccEngine>("counter-cas", &atomicUpdateCounter<STM::Occ::DefaultPolicy>, threads, ops);
+        runEngine<OccEagerEngine>("counter-cas", &atomicUpdateCounter<STM::Occ::EagerPolicy>, threads, ops);
+        runEngine<OccEngine>("counter-hot", &hotCounter<STM::Occ::DefaultPolicy>, threads, ops);
+        runEngine<OccEagerEngine>("counter-hot", &hotCounter<STM::Occ::EagerPolicy>, threads, ops);
+    }
+
+    std::fprintf(stderr, "\n%-12s %10s\n", "cold-start", "Mvars/s");
+    std::fprintf(stderr, "%-12s %10.3f\n", "new TMVar", coldStart<false>(1 << 21));
+    std::fprintf(stderr, "%-12s %10.3f\n", "TMVarArena", coldStart<true>(1 << 21));
+
+    return 0;
+}
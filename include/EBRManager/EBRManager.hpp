@@ -24,6 +24,11 @@ public:
     void enter();
     void leave();
 
+    // 静默屏障：返回时，调用前已处于临界区的线程都已离开，调用前 (在临界区内) 退休的对象
+    // 也都已回收完毕，包括其他线程已经取走、正在执行 deleter 的那部分。
+    // 不能在临界区内调用 (自己会阻止纪元推进)。
+    void synchronize();
+
     template<typename T>
     void retire(T* ptr);
     void retire(void* ptr, void (*deleter)(void*));
@@ -34,13 +39,16 @@ public:
 private:
     EBRManager();
     ~EBRManager();
-    bool tryAdvanceEpoch_();
+    // 尝试推进全局纪元，成功的线程负责回收两个纪元之前的垃圾
+    bool advanceAndCollect_();
     void collectGarbage_(uint64_t epoch_to_collect);
     ThreadSlot* getLocalSlot_();
 
 private:
     alignas(64) std::atomic<uint64_t> global_epoch_;
     LockFreeSingleLinkedList garbage_lists_[kNumEpochLists];
+    // 每个链表上进行中的回收数 (从推进纪元之前到 deleter 执行完)
+    std::atomic<uint32_t> collectors_[kNumEpochLists] = {};
 
     ThreadSlotManager slot_manager_;
     GarbageCollector garbage_collector_;
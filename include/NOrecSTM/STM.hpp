@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Transaction.hpp"
+#include "EBRManager/EBRManager.hpp"
+#include <thread>
+#include <type_traits>
+
+namespace STM {
+namespace NOrec {
+
+    inline TxDescriptor& getLocalDescriptor () {
+        static thread_local TxDescriptor desc;
+        return desc;
+    }
+
+    inline Transaction& getLocalTransaction () {
+        static thread_local Transaction tx(&getLocalDescriptor());
+        return tx;
+    }
+
+    template<typename T>
+    using Var = TMVar<T>;
+
+    // 与 STM::atomically 相同的用法，变量类型换成 NOrec::Var<T>。
+    // NOrec 的变量没有版本链，不能是 Occ::TMVar，而 STM::Var<T, Policy> 在 mcas、HotTMVar 等处
+    // 作为 Occ::TMVar 参与模板推导，因此与 Ring 一样提供平行的入口，而不是挂在 Policy 选择上
+    template<typename F>
+    auto atomically(F&& func) {
+        EBRManager::instance()->enter();
+
+        Transaction& tx = getLocalTransaction();
+
+        while (true) {
+            try {
+                tx.begin();
+
+                if constexpr (std::is_void_v<std::invoke_result_t<F, Transaction&>>) {
+                    func(tx);
+
+                    if(tx.commit()) {
+                        break;
+                    }
+                }
+                else {
+                    auto result = func(tx);
+                    if(tx.commit()) {
+                        EBRManager::instance()->leave();
+                        return result;
+                    }
+                }
+            }
+            catch(const RetryException&){
+                tx.abort();
+                std::this_thread::yield();
+                continue;
+            }
+            catch(...) {
+                tx.abort();
+                EBRManager::instance()->leave();
+                throw;
+            }
+        }
+
+        EBRManager::instance()->leave();
+    }
+
+} // namespace NOrec
+} // namespace STM
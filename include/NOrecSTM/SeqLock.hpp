@@ -0,0 +1,48 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <immintrin.h>
+
+namespace STM {
+namespace NOrec {
+
+// 全局顺序锁：偶数表示空闲，奇数表示有写事务正在写回。
+// 每次写回结束后序号 +2，读者用它判断快照是否仍然有效。
+class alignas(64) GlobalSeqLock {
+public:
+    GlobalSeqLock() = delete;
+    GlobalSeqLock(const GlobalSeqLock&) = delete;
+    GlobalSeqLock& operator=(const GlobalSeqLock&) = delete;
+
+    static uint64_t now() noexcept {
+        return seq_.load(std::memory_order_acquire);
+    }
+
+    // 等到没有写回进行，返回一个偶数快照
+    static uint64_t waitEven() noexcept {
+        uint64_t s = now();
+        while (s & 1) {
+            _mm_pause();
+            std::this_thread::yield();
+            s = now();
+        }
+        return s;
+    }
+
+    // 只有快照仍是最新时才能拿到锁
+    static bool tryLock(uint64_t snapshot) noexcept {
+        return seq_.compare_exchange_strong(snapshot, snapshot + 1, std::memory_order_acq_rel);
+    }
+
+    static void unlock() noexcept {
+        seq_.fetch_add(1, std::memory_order_release);
+    }
+
+private:
+    inline static std::atomic<uint64_t> seq_{0};
+};
+
+} // namespace NOrec
+} // namespace STM
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <atomic>
+#include <cstring>
+#include <type_traits>
+#include "EBRManager/EBRManager.hpp"
+#include "TierAlloc/ThreadHeap/ThreadHeap.hpp"
+
+namespace STM {
+namespace NOrec {
+
+namespace detail {
+
+// 不可变的值节点：写回时整体替换，没有版本号，也没有历史链
+template<typename T>
+struct ValueNode {
+    T payload;
+
+    template<typename... Args>
+    explicit ValueNode(Args&&... args) : payload(std::forward<Args>(args)...) {}
+
+    static void* operator new(size_t size) { return ThreadHeap::allocate(size); }
+    static void operator delete(void* p) { ThreadHeap::deallocate(p); }
+};
+
+template<typename T, typename = void>
+struct EqualityComparable : std::false_type {};
+
+template<typename T>
+struct EqualityComparable<T, std::void_t<decltype(std::declval<const T&>() == std::declval<const T&>())>>
+    : std::true_type {};
+
+// 值比较：优先用 ==，其次逐字节比较可平凡拷贝的类型，都不行只能退回节点身份
+template<typename T>
+bool sameValue(const ValueNode<T>* a, const ValueNode<T>* b) {
+    if (a == b) return true;
+
+    if constexpr (EqualityComparable<T>::value) {
+        return static_cast<bool>(a->payload == b->payload);
+    }
+    else if constexpr (std::is_trivially_copyable_v<T>) {
+        return std::memcmp(&a->payload, &b->payload, sizeof(T)) == 0;
+    }
+    else {
+        return false;
+    }
+}
+
+} // namespace detail
+
+
+// NOrec 的变量只保存一个指向当前值的指针，没有锁也没有版本链。
+// 读集记录读到的节点 (节点不可变，在 EBR 临界区内不会被回收)，验证时按值与当前节点比较：
+// 写回相同值的并发写入不会让读者中止。
+template<typename T>
+class TMVar {
+public:
+    using Node = detail::ValueNode<T>;
+
+    template<typename... Args>
+    explicit TMVar(Args&&... args);
+
+    ~TMVar();
+
+    Node* loadHead() const { return head_.load(std::memory_order_acquire); }
+
+    // 静态生命周期管理函数
+    static bool unchanged(const void* addr, const void* seen);
+    static void committer(void* tmvar_ptr, void* node_ptr);
+    static void deleter(void* p);
+
+    TMVar(const TMVar&) = delete;
+    TMVar& operator=(const TMVar&) = delete;
+
+private:
+    std::atomic<Node*> head_{nullptr};
+};
+
+
+template<typename T>
+template<typename... Args>
+TMVar<T>::TMVar(Args&&... args) {
+    head_.store(new Node(std::forward<Args>(args)...), std::memory_order_release);
+}
+
+template<typename T>
+TMVar<T>::~TMVar() {
+    delete head_.load(std::memory_order_acquire);
+}
+
+template<typename T>
+bool TMVar<T>::unchanged(const void* addr, const void* seen) {
+    return detail::sameValue(static_cast<const TMVar*>(addr)->loadHead(), static_cast<const Node*>(seen));
+}
+
+// 只在持有全局顺序锁时调用：替换指针，旧节点交给 EBR
+template<typename T>
+void TMVar<T>::committer(void* tmvar_ptr, void* node_ptr) {
+    auto* tmvar = static_cast<TMVar*>(tmvar_ptr);
+    Node* old = tmvar->head_.exchange(static_cast<Node*>(node_ptr), std::memory_order_acq_rel);
+    EBRManager::instance()->retire(old, TMVar::deleter);
+}
+
+template<typename T>
+void TMVar<T>::deleter(void* p) {
+    delete static_cast<Node*>(p);
+}
+
+} // namespace NOrec
+} // namespace STM
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <vector>
+
+#include "SeqLock.hpp"
+#include "TMVar.hpp"
+#include "TierAlloc/ThreadHeap/ThreadHeap.hpp"
+
+namespace STM {
+namespace NOrec {
+
+struct RetryException : public std::exception {};
+
+struct ReadLogEntry {
+    const void* tmvar_addr;
+    const void* seen;       // 读到的节点，验证时比较其中的值
+
+    using Checker = bool (*)(const void* tmvar_addr, const void* seen);
+    Checker checker;
+};
+
+struct WriteLogEntry {
+    void* tmvar_addr;
+    void* new_node;
+
+    using Committer = void (*)(void* tmvar, void* node);
+    Committer committer;
+
+    using Deleter = void (*)(void* node);
+    Deleter deleter;
+};
+
+
+// 事务状态：一个快照序号 + 按值记录的读集 + 重做写集
+class TxDescriptor {
+public:
+    TxDescriptor() {
+        read_set_.reserve(64);
+        write_set_.reserve(16);
+    }
+
+    ~TxDescriptor() {
+        reset();
+    }
+
+    void reset() {
+        for (void* ptr : allocated_ptrs_) {
+            ThreadHeap::deallocate(ptr);
+        }
+        allocated_ptrs_.clear();
+
+        for (WriteLogEntry& entry : write_set_) {
+            if (entry.deleter && entry.new_node) {
+                entry.deleter(entry.new_node);
+            }
+        }
+        write_set_.clear();
+
+        read_set_.clear();
+        snapshot_ = 0;
+    }
+
+    uint64_t snapshot() const { return snapshot_; }
+    void setSnapshot(uint64_t s) { snapshot_ = s; }
+
+    std::vector<ReadLogEntry>& readSet() { return read_set_; }
+    std::vector<WriteLogEntry>& writeSet() { return write_set_; }
+
+    void recordAllocation(void* ptr) { allocated_ptrs_.push_back(ptr); }
+    void commitAllocations() { allocated_ptrs_.clear(); }
+
+private:
+    uint64_t snapshot_{0};
+    std::vector<ReadLogEntry> read_set_;
+    std::vector<WriteLogEntry> write_set_;
+    std::vector<void*> allocated_ptrs_;
+};
+
+
+class Transaction {
+public:
+    explicit Transaction(TxDescriptor* desc) : desc_(desc) {}
+
+    void begin();
+    bool commit();
+    void abort() { desc_->reset(); }
+
+    template<typename T>
+    T load(TMVar<T>& var);
+
+    template<typename T>
+    void store(TMVar<T>& var, const T& val);
+
+    template<typename T, typename... Args>
+    T* alloc(Args&&... args);
+
+    template<typename T>
+    void free(T* ptr);
+
+private:
+    // 等到没有写回时逐项比对读集；一致则把快照推进到当前序号
+    bool validate_();
+
+private:
+    TxDescriptor* desc_;
+};
+
+
+template<typename T>
+T Transaction::load(TMVar<T>& var) {
+    using Node = typename TMVar<T>::Node;
+
+    // 1. Read-Your-Own-Writes
+    auto& wset = desc_->writeSet();
+    for (auto it = wset.rbegin(); it != wset.rend(); ++it) {
+        if (it->tmvar_addr == &var) return static_cast<Node*>(it->new_node)->payload;
+    }
+
+    // 2. 读取期间序号没变，说明读到的值属于当前快照；
+    //    否则先按值验证旧读集，再重新读取
+    Node* curr = var.loadHead();
+    std::atomic_thread_fence(std::memory_order_acquire);
+    while (GlobalSeqLock::now() != desc_->snapshot()) {
+        if (!validate_()) {
+            throw RetryException();
+        }
+        curr = var.loadHead();
+        std::atomic_thread_fence(std::memory_order_acquire);
+    }
+
+    desc_->readSet().push_back({&var, curr, TMVar<T>::unchanged});
+    return curr->payload;
+}
+
+template<typename T>
+void Transaction::store(TMVar<T>& var, const T& val) {
+    using Node = typename TMVar<T>::Node;
+
+    // 同一变量重复写入：直接替换写集中的节点
+    for (auto& entry : desc_->writeSet()) {
+        if (entry.tmvar_addr == &var) {
+            Node* node = new Node(val);
+            entry.deleter(entry.new_node);
+            entry.new_node = node;
+            return;
+        }
+    }
+
+    desc_->writeSet().push_back({&var, new Node(val), TMVar<T>::committer, TMVar<T>::deleter});
+}
+
+template<typename T, typename... Args>
+T* Transaction::alloc(Args&&... args) {
+    void* raw_mem = ThreadHeap::allocate(sizeof(T));
+    desc_->recordAllocation(raw_mem);
+    return new(raw_mem) T(std::forward<Args>(args)...);
+}
+
+template<typename T>
+void Transaction::free(T* ptr) {
+    if (!ptr) return;
+
+    ptr->~T();
+    ThreadHeap::deallocate(ptr);
+}
+
+} // namespace NOrec
+} // namespace STM
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+namespace STM {
+namespace Occ {
+
+// =========================================================
+// 准入控制 (Admission)
+// =========================================================
+// 由 BasicTransaction 回调：begin 时为"上一次尝试写过东西却中止了"的事务申请令牌，
+// 提交/中止时归还令牌并报告结果。首次尝试与只读事务从不等待，只有重试中的写事务受限。
+// acquire(stop) 在等待期间反复调用 stop()，返回 true 时放弃 (带期限的 begin 借此在期限到期时返回)。
+
+// 不做准入控制 (默认)，所有钩子都会被编译器消除
+struct NoAdmission {
+    static constexpr bool kEnabled = false;
+
+    template<typename Stop>
+    static bool acquire(Stop&&) noexcept { return true; }
+    static void release() noexcept {}
+    static void onCommit() noexcept {}
+    static void onAbort() noexcept {}
+};
+
+// 自适应准入：全局令牌信号量 + AIMD 调整上限。
+// 每 kWindow 个提交/中止事件为一个窗口：中止率高于 kHighAbortRatio 时上限减半，
+// 低于 kLowAbortRatio 时上限加一 (最多为硬件线程数)。中止风暴时重试者排队进入，
+// 而不是同时重试、互相冲掉，吞吐量在争用拐点之后保持平稳。
+// 结果先在线程内攒 kFlushBatch 个再合入全局窗口，提交路径上没有全局热点。
+struct AdaptiveAdmission {
+    static constexpr bool kEnabled = true;
+
+    static constexpr uint32_t kWindow = 256;
+    static constexpr uint32_t kFlushBatch = 8;
+    static constexpr double kHighAbortRatio = 0.5;
+    static constexpr double kLowAbortRatio = 0.1;
+
+    struct Metrics {
+        int limit;              // 当前允许同时重试的写事务数
+        int max_limit;
+        int in_flight;          // 持有令牌的事务数
+        uint64_t commits;       // 累计 (已合入全局的部分)
+        uint64_t aborts;
+        uint64_t throttled;     // 因没有令牌而等待过的次数
+        double window_abort_ratio;  // 最近一个完整窗口的中止率
+    };
+
+    // 等待令牌；等待期间 stop() 返回 true 时放弃，返回 false (未拿到令牌)
+    template<typename Stop>
+    static bool acquire(Stop&& stop) {
+        State& s = state();
+        bool waited = false;
+
+        while (true) {
+            int cur = s.in_flight.load(std::memory_order_relaxed);
+            if (cur < s.limit.load(std::memory_order_relaxed) &&
+                s.in_flight.compare_exchange_weak(cur, cur + 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+                return true;
+            }
+            if (!waited) {
+                waited = true;
+                s.throttled.fetch_add(1, std::memory_order_relaxed);
+            }
+            if (stop()) return false;
+            std::this_thread::yield();
+        }
+    }
+
+    static void release() noexcept {
+        state().in_flight.fetch_sub(1, std::memory_order_release);
+    }
+
+    static void onCommit() noexcept { record(1, 0); }
+    static void onAbort() noexcept { record(0, 1); }
+
+    static Metrics metrics() noexcept {
+        const State& s = state();
+        return Metrics{
+            s.limit.load(std::memory_order_relaxed),
+            s.max_limit,
+            s.in_flight.load(std::memory_order_relaxed),
+            s.commits.load(std::memory_order_relaxed),
+            s.aborts.load(std::memory_order_relaxed),
+            s.throttled.load(std::memory_order_relaxed),
+            s.window_abort_ratio.load(std::memory_order_relaxed),
+        };
+    }
+
+    // 恢复初始状态 (上限为硬件线程数)，不影响持有中的令牌。各线程尚未合入的结果不清除
+    static void reset() noexcept {
+        State& s = state();
+        s.limit.store(s.max_limit, std::memory_order_relaxed);
+        s.window.store(0, std::memory_order_relaxed);
+        s.commits.store(0, std::memory_order_relaxed);
+        s.aborts.store(0, std::memory_order_relaxed);
+        s.throttled.store(0, std::memory_order_relaxed);
+        s.window_abort_ratio.store(0.0, std::memory_order_relaxed);
+    }
+
+private:
+    struct State {
+        const int max_limit = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+
+        alignas(64) std::atomic<int> in_flight{0};
+        alignas(64) std::atomic<int> limit{max_limit};
+
+        // 当前窗口：高 32 位为中止数，低 32 位为提交数
+        alignas(64) std::atomic<uint64_t> window{0};
+
+        alignas(64) std::atomic<uint64_t> commits{0};
+        std::atomic<uint64_t> aborts{0};
+        std::atomic<uint64_t> throttled{0};
+        std::atomic<double> window_abort_ratio{0.0};
+    };
+
+    struct LocalBatch {
+        uint32_t commits = 0;
+        uint32_t aborts = 0;
+    };
+
+    static State& state() noexcept {
+        static State s;
+        return s;
+    }
+
+    static void record(uint32_t commits, uint32_t aborts) noexcept {
+        static thread_local LocalBatch batch;
+        batch.commits += commits;
+        batch.aborts += aborts;
+        if (batch.commits + batch.aborts < kFlushBatch) return;
+
+        flush(batch.commits, batch.aborts);
+        batch = LocalBatch{};
+    }
+
+    static void flush(uint32_t commits, uint32_t aborts) noexcept {
+        State& s = state();
+        s.commits.fetch_add(commits, std::memory_order_relaxed);
+        s.aborts.fetch_add(aborts, std::memory_order_relaxed);
+
+        uint64_t add = (static_cast<uint64_t>(aborts) << 32) | commits;
+        uint64_t total = s.window.fetch_add(add, std::memory_order_acq_rel) + add;
+
+        uint64_t window_commits = total & 0xFFFFFFFFu;
+        uint64_t window_aborts = total >> 32;
+        if (window_commits + window_aborts < kWindow) return;
+
+        // 只有清空窗口的那个线程调整上限
+        if (!s.window.compare_exchange_strong(total, 0, std::memory_order_acq_rel)) return;
+
+        double ratio = static_cast<double>(window_aborts) / static_cast<double>(window_commits + window_aborts);
+        s.window_abort_ratio.store(ratio, std::memory_order_relaxed);
+
+        int limit = s.limit.load(std::memory_order_relaxed);
+        if (ratio > kHighAbortRatio) {
+            limit = std::max(1, limit / 2);
+        }
+        else if (ratio < kLowAbortRatio) {
+            limit = std::min(s.max_limit, limit + 1);
+        }
+        s.limit.store(limit, std::memory_order_relaxed);
+    }
+};
+
+} // namespace Occ
+} // namespace STM
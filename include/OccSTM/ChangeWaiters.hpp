@@ -0,0 +1,116 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+// 协程事务开关，由 CMake 的 STM_ENABLE_COROUTINES 选项定义。
+// 关闭时没有人会等待变量变化，所有提交路径上的唤醒检查 (ChangeWaiters::changed) 编译为空。
+#ifndef STM_ENABLE_COROUTINES
+#define STM_ENABLE_COROUTINES 0
+#endif
+
+namespace STM {
+namespace Occ {
+
+// 变量变更的等待登记表：阻塞在 tx.retry() 上的协程事务 (见 OccSTM/Coroutine.hpp) 按读集中的变量地址登记，
+// 任何提交路径写入这些变量后调用 changed 把它们唤醒。没有等待者时，提交路径只多一次全屏障和原子读 (any)；
+// 未开启协程事务时什么都不做。
+class ChangeWaiters {
+public:
+    static constexpr bool kEnabled = STM_ENABLE_COROUTINES != 0;
+
+    // 一个等待者可以登记在多个变量上，只会被唤醒一次
+    struct Waiter {
+        explicit Waiter(std::function<void()> fn) : wake(std::move(fn)) {}
+
+        std::atomic<bool> fired{false};
+        std::function<void()> wake;
+
+        void fire() {
+            if (!fired.exchange(true, std::memory_order_acq_rel)) wake();
+        }
+    };
+
+    static ChangeWaiters& instance() {
+        static ChangeWaiters waiters;
+        return waiters;
+    }
+
+    // 提交路径在发布新版本之后调用 (可在持锁时或解锁后)
+    static void changed(const void* addr) {
+        if constexpr (kEnabled) {
+            ChangeWaiters& waiters = instance();
+            if (waiters.any()) waiters.notify(addr);
+        }
+    }
+
+    // 与 wait 中的登记构成 Dekker 式配对：写者 "发布 -> 全屏障 -> 查 count_"，
+    // 等待者 "登记 -> 全屏障 -> 重新验证读集" (见 AtomicallyAwaiter::park_)，保证至少一方看到对方
+    bool any() const noexcept {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        return count_.load(std::memory_order_relaxed) > 0;
+    }
+
+    // 登记之后调用者必须先执行 seq_cst 屏障，再重新检查变量是否已经变化 (见 any)
+    void wait(const void* addr, const std::shared_ptr<Waiter>& waiter) {
+        Bucket& bucket = bucketOf_(addr);
+        std::lock_guard<std::mutex> lock(bucket.mutex);
+
+        // 顺带清掉已经被其他变量唤醒过的登记
+        size_t kept = 0;
+        for (auto& entry : bucket.entries) {
+            if (!entry.second->fired.load(std::memory_order_relaxed)) {
+                bucket.entries[kept++] = std::move(entry);
+            }
+        }
+        count_.fetch_sub(bucket.entries.size() - kept, std::memory_order_relaxed);
+        bucket.entries.resize(kept);
+
+        bucket.entries.emplace_back(addr, waiter);
+        count_.fetch_add(1, std::memory_order_seq_cst);
+    }
+
+    void notify(const void* addr) {
+        std::vector<std::shared_ptr<Waiter>> woken;
+        {
+            Bucket& bucket = bucketOf_(addr);
+            std::lock_guard<std::mutex> lock(bucket.mutex);
+
+            size_t kept = 0;
+            for (auto& entry : bucket.entries) {
+                if (entry.first == addr) woken.push_back(std::move(entry.second));
+                else bucket.entries[kept++] = std::move(entry);
+            }
+            bucket.entries.resize(kept);
+        }
+        count_.fetch_sub(woken.size(), std::memory_order_relaxed);
+
+        // 回调在锁外执行
+        for (auto& waiter : woken) waiter->fire();
+    }
+
+private:
+    static constexpr size_t kBuckets = 64;
+
+    struct alignas(64) Bucket {
+        std::mutex mutex;
+        std::vector<std::pair<const void*, std::shared_ptr<Waiter>>> entries;
+    };
+
+    ChangeWaiters() = default;
+
+    Bucket& bucketOf_(const void* addr) noexcept {
+        return buckets_[std::hash<const void*>{}(addr) % kBuckets];
+    }
+
+    std::atomic<size_t> count_{0};
+    Bucket buckets_[kBuckets];
+};
+
+} // namespace Occ
+} // namespace STM
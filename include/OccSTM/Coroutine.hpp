@@ -0,0 +1,289 @@
+#pragma once
+
+#if __cplusplus < 202002L
+#error "OccSTM/Coroutine.hpp requires C++20 (configure with -DSTM_ENABLE_COROUTINES=ON)"
+#endif
+
+// 提交路径只在所有翻译单元都定义了 STM_ENABLE_COROUTINES 时才唤醒等待者 (见 ChangeWaiters.hpp)
+#if !defined(STM_ENABLE_COROUTINES) || !STM_ENABLE_COROUTINES
+#error "OccSTM/Coroutine.hpp requires STM_ENABLE_COROUTINES=1 (configure with -DSTM_ENABLE_COROUTINES=ON)"
+#endif
+
+#include "STM.hpp"
+#include "TxExecutor.hpp"
+#include "ChangeWaiters.hpp"
+#include <coroutine>
+#include <exception>
+#include <future>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace STM {
+namespace Occ {
+
+// 协程事务：在 TxExecutor 上以 C++20 协程的形式执行事务。
+//
+//   STM::Occ::CoTask<int> take(STM::Occ::TxExecutor& exec, STM::Occ::TMVar<int>& items) {
+//       co_return co_await STM::Occ::co_atomically(exec, [&](STM::Occ::Transaction& tx) {
+//           int n = tx.load(items);
+//           if (n == 0) tx.retry();   // 挂起协程，直到 items 被修改
+//           tx.store(items, n - 1);
+//           return n;
+//       });
+//   }
+//
+// 与 atomically 的区别：
+//   - 冲突中止后不在原线程自旋重试，而是把下一次尝试重新投递到执行器，工作线程可以先去执行别的任务；
+//   - tx.retry() 不占用线程：协程按读集登记到 ChangeWaiters，任何提交 (事务、atomicUpdate、mcas、HotTMVar)
+//     修改了读过的变量后才重新投递。Eager 策略没有按变量的读集，retry 退化为重新投递。
+// 事务体的要求与 TxExecutor::submit 相同；协程恢复后运行在执行器的工作线程上。
+
+template<typename R = void>
+class CoTask;
+
+namespace detail {
+
+    template<typename R>
+    struct CoResult {
+        std::optional<R> value;
+
+        template<typename V>
+        void return_value(V&& v) { value.emplace(std::forward<V>(v)); }
+
+        R take() { return std::move(*value); }
+    };
+
+    template<>
+    struct CoResult<void> {
+        void return_void() noexcept {}
+        void take() noexcept {}
+    };
+
+} // namespace detail
+
+
+// 惰性启动的协程任务：被 co_await 或 get() 时才开始执行，完成后恢复等待者
+template<typename R>
+class CoTask {
+public:
+    struct promise_type : detail::CoResult<R> {
+        std::exception_ptr error;
+        std::coroutine_handle<> continuation;
+        std::shared_ptr<std::promise<void>> done;   // get() 的同步等待
+
+        CoTask get_return_object() {
+            return CoTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+
+        struct FinalAwaiter {
+            bool await_ready() const noexcept { return false; }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> h) noexcept {
+                promise_type& p = h.promise();
+                if (p.continuation) return p.continuation;
+
+                // 先拷贝到局部：set_value 之后 get() 的线程可能立刻销毁协程帧
+                auto done = p.done;
+                if (done) done->set_value();
+                return std::noop_coroutine();
+            }
+
+            void await_resume() const noexcept {}
+        };
+
+        FinalAwaiter final_suspend() noexcept { return {}; }
+
+        void unhandled_exception() { error = std::current_exception(); }
+
+        R result() {
+            if (error) std::rethrow_exception(error);
+            return this->take();
+        }
+    };
+
+    using Handle = std::coroutine_handle<promise_type>;
+
+    CoTask(CoTask&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+
+    CoTask& operator=(CoTask&& other) noexcept {
+        if (this != &other) {
+            if (handle_) handle_.destroy();
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+        return *this;
+    }
+
+    CoTask(const CoTask&) = delete;
+    CoTask& operator=(const CoTask&) = delete;
+
+    ~CoTask() {
+        if (handle_) handle_.destroy();
+    }
+
+    auto operator co_await() && noexcept {
+        struct Awaiter {
+            Handle handle;
+
+            bool await_ready() const noexcept { return false; }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> continuation) noexcept {
+                handle.promise().continuation = continuation;
+                return handle;
+            }
+
+            R await_resume() { return handle.promise().result(); }
+        };
+        return Awaiter{handle_};
+    }
+
+    // 在当前线程启动协程并阻塞到它完成。不能在执行器的工作线程上调用 (可能占住唯一的工作线程)
+    R get() {
+        auto done = std::make_shared<std::promise<void>>();
+        std::future<void> finished = done->get_future();
+
+        handle_.promise().done = done;
+        handle_.resume();
+        finished.wait();
+
+        return handle_.promise().result();
+    }
+
+private:
+    explicit CoTask(Handle handle) noexcept : handle_(handle) {}
+
+    Handle handle_;
+};
+
+
+// co_atomically 返回的等待体。它存放在协程帧里，挂起期间地址不变，投递的任务直接捕获 this。
+// 每个 step_ 结束时要么恢复协程，要么把 this 交给下一个任务，之后不再访问成员。
+template<typename Policy, typename F>
+class AtomicallyAwaiter {
+    using Tx = BasicTransaction<Policy>;
+
+public:
+    using Result = std::invoke_result_t<F&, Tx&>;
+
+    AtomicallyAwaiter(TxExecutor& exec, F func) : exec_(exec), func_(std::move(func)) {}
+
+    bool await_ready() const noexcept { return false; }
+
+    void await_suspend(std::coroutine_handle<> handle) {
+        handle_ = handle;
+        exec_.post([this]() { step_(); });
+    }
+
+    Result await_resume() {
+        if (error_) std::rethrow_exception(error_);
+        if constexpr (!std::is_void_v<Result>) return std::move(*result_);
+    }
+
+private:
+    void step_();
+
+    // tx.retry()：按读集登记等待，返回后不能再访问 this
+    void park_(Tx& tx);
+
+    void repost_() {
+        exec_.post([this]() { step_(); });
+    }
+
+    TxExecutor& exec_;
+    F func_;
+    std::coroutine_handle<> handle_;
+    std::conditional_t<std::is_void_v<Result>, char, std::optional<Result>> result_{};
+    std::exception_ptr error_;
+    int retry_count_ = 0;
+};
+
+template<typename Policy, typename F>
+void AtomicallyAwaiter<Policy, F>::step_() {
+    EBRManager::instance()->enter();
+    Tx& tx = getLocalTransaction<Policy>();
+
+    bool committed = false;
+    try {
+        tx.begin();
+
+        if constexpr (std::is_void_v<Result>) {
+            func_(tx);
+        }
+        else {
+            result_.reset();
+            result_.emplace(func_(tx));
+        }
+        committed = tx.commit();
+    }
+    catch (const WaitException&) {
+        if constexpr (!Policy::kEagerWrites) {
+            park_(tx);
+            EBRManager::instance()->leave();
+            return;
+        }
+        else {
+            tx.abort();
+        }
+    }
+    catch (const RetryException&) {
+        tx.abort();
+    }
+    catch (...) {
+        tx.abort();
+        error_ = std::current_exception();
+    }
+
+    EBRManager::instance()->leave();
+
+    if (committed || error_) {
+        handle_.resume();
+        return;
+    }
+
+    Policy::Logger::onRetry(++retry_count_);
+    repost_();
+}
+
+template<typename Policy, typename F>
+void AtomicallyAwaiter<Policy, F>::park_(Tx& tx) {
+    auto& desc = getLocalDescriptor<Policy>();
+    std::vector<ReadLogEntry> reads(desc.readSet().begin(), desc.readSet().end());
+    uint64_t rv = desc.getReadVersion();
+    tx.abort();
+
+    // 没读过任何变量：没有可以等待的东西，只能重新投递
+    if (reads.empty()) {
+        repost_();
+        return;
+    }
+
+    auto& waiters = ChangeWaiters::instance();
+    auto waiter = std::make_shared<ChangeWaiters::Waiter>([this]() { repost_(); });
+
+    // 登记之后其他线程随时可能唤醒并恢复协程，从这里开始只访问局部变量
+    for (const auto& entry : reads) waiters.wait(entry.tmvar_addr, waiter);
+
+    // 与写者 any() 中的屏障配对：登记对写者可见之前，不能先读到旧的 head
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    // 读集在登记之前就已经失效：写者可能错过了我们的登记，自己唤醒
+    for (const auto& entry : reads) {
+        if (!entry.validator(entry.tmvar_addr, entry.expected_head, rv)) {
+            waiter->fire();
+            break;
+        }
+    }
+}
+
+
+template<typename Policy = DefaultPolicy, typename F>
+AtomicallyAwaiter<Policy, std::decay_t<F>> co_atomically(TxExecutor& exec, F&& func) {
+    return AtomicallyAwaiter<Policy, std::decay_t<F>>(exec, std::forward<F>(func));
+}
+
+} // namespace Occ
+} // namespace STM
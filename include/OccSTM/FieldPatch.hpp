@@ -0,0 +1,144 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "TierAlloc/ThreadHeap/ThreadHeap.hpp"
+#include "VersionNode.hpp"
+
+namespace STM {
+namespace Occ {
+
+namespace detail {
+
+// 字段级写入的日志：按调用顺序记录若干对 T 的修改，提交时在当前版本的拷贝上依次应用，得到新版本。
+// 可平凡拷贝的字段/元素赋值 (modify / modifyAt 的常见情形) 内联存放为 "应用函数 + 字节"：
+// 字节中是成员指针 (或下标) 与新值，不分配闭包；其余修改 (非平凡字段、patch 的任意 op) 退回 std::function。
+template<typename T>
+struct FieldPatch {
+    // 按字节读出成员指针与新值并赋值
+    using Applier = void (*)(T& target, const unsigned char* bytes);
+
+    // 日志中每条修改的头部，其后紧跟 size 字节；apply 为空表示调用 fns[size]
+    struct OpHeader {
+        Applier apply;
+        size_t size;
+    };
+
+    // 前 kInlineBytes 字节的日志放在记录内部，更长时整体搬到堆上
+    static constexpr size_t kInlineBytes = 96;
+
+    FieldPatch() = default;
+    FieldPatch(const FieldPatch&) = delete;
+    FieldPatch& operator=(const FieldPatch&) = delete;
+
+    ~FieldPatch() { delete base_copy; }
+
+    // C 总是 T (形参不直接写成 M T::*，以便 T 为标量时也能实例化本类)
+    template<typename M, typename C>
+    void assign(M C::* field, const M& value) {
+        static_assert(std::is_trivially_copyable_v<M>, "inline field ops require trivially copyable fields");
+
+        unsigned char* p = append_(sizeof(OpHeader) + sizeof(field) + sizeof(M));
+        OpHeader header{&assignField_<M, C>, sizeof(field) + sizeof(M)};
+        std::memcpy(p, &header, sizeof(header));
+        std::memcpy(p + sizeof(header), &field, sizeof(field));
+        std::memcpy(p + sizeof(header) + sizeof(field), &value, sizeof(M));
+    }
+
+    // 元素赋值 target[index] = value (T 为 std::array 等数组类型时使用)
+    template<typename M>
+    void assignAt(size_t index, const M& value) {
+        static_assert(std::is_trivially_copyable_v<M>, "inline element ops require trivially copyable elements");
+
+        unsigned char* p = append_(sizeof(OpHeader) + sizeof(index) + sizeof(M));
+        OpHeader header{&assignElement_<M>, sizeof(index) + sizeof(M)};
+        std::memcpy(p, &header, sizeof(header));
+        std::memcpy(p + sizeof(header), &index, sizeof(index));
+        std::memcpy(p + sizeof(header) + sizeof(index), &value, sizeof(M));
+    }
+
+    template<typename F>
+    void add(F&& op) {
+        OpHeader header{nullptr, fns.size()};
+        fns.emplace_back(std::forward<F>(op));
+        std::memcpy(append_(sizeof(header)), &header, sizeof(header));
+    }
+
+    void applyTo(T& target) const {
+        const unsigned char* p = data_();
+        const unsigned char* end = p + used_;
+        while (p < end) {
+            OpHeader header;
+            std::memcpy(&header, p, sizeof(header));
+            p += sizeof(header);
+
+            if (header.apply == nullptr) {
+                fns[header.size](target);
+            }
+            else {
+                header.apply(target, p);
+                p += header.size;
+            }
+        }
+    }
+
+    std::vector<std::function<void(T&)>> fns;
+
+    // 提交前 (锁外) 预先拷贝的当前版本及其来源，见 TMVar::patchPreparer / patchCommitter
+    VersionNode<T>* base_copy = nullptr;
+    const VersionNode<T>* base = nullptr;
+    uint64_t base_ts = 0;
+
+    static void* operator new(size_t size) { return ThreadHeap::allocate(size); }
+    static void operator delete(void* p) { ThreadHeap::deallocate(p); }
+
+private:
+    template<typename M, typename C>
+    static void assignField_(T& target, const unsigned char* bytes) {
+        M C::* field;
+        std::memcpy(&field, bytes, sizeof(field));
+        std::memcpy(&(target.*field), bytes + sizeof(field), sizeof(M));
+    }
+
+    template<typename M>
+    static void assignElement_(T& target, const unsigned char* bytes) {
+        size_t index;
+        std::memcpy(&index, bytes, sizeof(index));
+        std::memcpy(&target[index], bytes + sizeof(index), sizeof(M));
+    }
+
+    const unsigned char* data_() const { return heap_.empty() ? inline_ : heap_.data(); }
+
+    unsigned char* append_(size_t n) {
+        size_t offset = used_;
+        used_ += n;
+        if (heap_.empty() && used_ <= kInlineBytes) return inline_ + offset;
+
+        if (heap_.empty()) heap_.assign(inline_, inline_ + offset);
+        heap_.resize(used_);
+        return heap_.data() + offset;
+    }
+
+    alignas(OpHeader) unsigned char inline_[kInlineBytes];
+    std::vector<unsigned char> heap_;
+    size_t used_ = 0;
+};
+
+// patches 按从新到旧排列 (写集逆序查找的顺序)，按从旧到新应用
+template<typename T>
+T applyPatches(const T& base, const std::vector<const FieldPatch<T>*>& patches) {
+    T result(base);
+    for (auto it = patches.rbegin(); it != patches.rend(); ++it) {
+        (*it)->applyTo(result);
+    }
+    return result;
+}
+
+}
+
+}
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace STM {
+namespace Occ {
+
+// tx.fork 使用的全局工作线程池。
+// 等待子任务的线程会通过 tryRunOne 帮忙执行排队任务，因此嵌套 fork 或线程池繁忙时不会死锁。
+class ForkPool {
+public:
+    static ForkPool& instance();
+
+    ForkPool(const ForkPool&) = delete;
+    ForkPool& operator=(const ForkPool&) = delete;
+
+    void submit(std::function<void()> task);
+
+    // 在调用线程上执行一个排队任务；队列为空时返回 false
+    bool tryRunOne();
+
+    size_t workerCount() const noexcept { return workers_.size(); }
+
+private:
+    ForkPool();
+    ~ForkPool();
+
+    void workerLoop_();
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<std::function<void()>> tasks_;
+    std::vector<std::thread> workers_;
+    bool stop_ = false;
+};
+
+} // namespace Occ
+} // namespace STM
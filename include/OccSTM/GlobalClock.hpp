@@ -6,11 +6,13 @@
 namespace STM {
 namespace Occ {
 
-class alignas(64) GlobalClock {
+// Tag 用于区分互相独立的时钟域：不同 Tag 实例化出各自的计数器
+template<typename Tag = void>
+class alignas(64) BasicGlobalClock {
 public:
-    GlobalClock() = delete;
-    GlobalClock(const GlobalClock&) = delete;
-    GlobalClock& operator=(const GlobalClock&) = delete;
+    BasicGlobalClock() = delete;
+    BasicGlobalClock(const BasicGlobalClock&) = delete;
+    BasicGlobalClock& operator=(const BasicGlobalClock&) = delete;
 
     static uint64_t now() noexcept {
         return clock_.load(std::memory_order_acquire);
@@ -24,5 +26,7 @@ private:
     inline static std::atomic<uint64_t> clock_{0};
 };
 
+using GlobalClock = BasicGlobalClock<>;
+
+}
 }
-}
\ No newline at end of file
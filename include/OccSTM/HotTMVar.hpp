@@ -0,0 +1,195 @@
+#pragma once
+
+#include "TMVar.hpp"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <immintrin.h>
+
+namespace STM {
+namespace Occ {
+
+// 热点变量：在 TMVar 的基础上增加平面合并 (flat combining) 的更新通道。
+// 事务仍可照常 tx.load / tx.store；大量线程都在做读-改-写时改用 hot.update(f)：
+// 各线程把 f 发布到自己的槽位，拿到条带锁的线程成为合并者，一次性执行整批操作，
+// 只挂一个新版本、只 tick 一次时钟。竞争越激烈，每批合并的操作越多。
+template<typename T, typename Policy = DefaultPolicy, size_t Slots = 64>
+class HotTMVar : public TMVar<T, Policy> {
+public:
+    using Base = TMVar<T, Policy>;
+    using Node = typename Base::Node;
+
+    using Base::Base;
+
+    // 以 f(旧值) 作为新值，返回新值；f 抛出的异常转交给调用者，该操作不生效
+    template<typename F>
+    T update(F&& f);
+
+private:
+    enum : uint32_t { kEmpty = 0, kClaimed = 1, kPending = 2, kDone = 3 };
+
+    struct alignas(64) Slot {
+        std::atomic<uint32_t> state{kEmpty};
+        T (*op)(void* ctx, const T& current) = nullptr;
+        void* ctx = nullptr;
+        std::optional<T>* result = nullptr;
+        std::exception_ptr* error = nullptr;
+    };
+
+    template<typename F>
+    static T invoke_(void* ctx, const T& current) {
+        return (*static_cast<F*>(ctx))(current);
+    }
+
+    Slot& claimSlot_();
+    bool tryAcquire_(size_t idx, uint64_t& version);
+    void combine_(size_t idx, uint64_t version);
+
+    std::array<Slot, Slots> slots_;
+};
+
+
+template<typename T, typename Policy, size_t Slots>
+template<typename F>
+T HotTMVar<T, Policy, Slots>::update(F&& f) {
+    using Fn = std::remove_reference_t<F>;
+
+    std::optional<T> result;
+    std::exception_ptr error;
+
+    // 1. 发布
+    Slot& slot = claimSlot_();
+    slot.op = &invoke_<Fn>;
+    slot.ctx = const_cast<void*>(static_cast<const void*>(&f));
+    slot.result = &result;
+    slot.error = &error;
+    slot.state.store(kPending, std::memory_order_release);
+
+    // 2. 等待合并者，或自己成为合并者
+    auto& lock_table = Policy::LockTable::instance();
+    size_t idx = lock_table.getStripeIndex(static_cast<Base*>(this));
+
+    while (slot.state.load(std::memory_order_acquire) != kDone) {
+        uint64_t version;
+        if (tryAcquire_(idx, version)) {
+            combine_(idx, version);
+        }
+        else {
+            _mm_pause();
+            std::this_thread::yield();
+        }
+    }
+
+    slot.state.store(kEmpty, std::memory_order_release);
+
+    if (error) std::rethrow_exception(error);
+    return std::move(*result);
+}
+
+// 线程优先使用固定的槽位，被占用时线性探测下一个
+template<typename T, typename Policy, size_t Slots>
+typename HotTMVar<T, Policy, Slots>::Slot& HotTMVar<T, Policy, Slots>::claimSlot_() {
+    static std::atomic<size_t> next_id{0};
+    static thread_local size_t preferred = next_id.fetch_add(1, std::memory_order_relaxed);
+
+    for (size_t i = preferred;; ++i) {
+        Slot& slot = slots_[i % Slots];
+        uint32_t expected = kEmpty;
+        if (slot.state.load(std::memory_order_relaxed) == kEmpty &&
+            slot.state.compare_exchange_strong(expected, kClaimed, std::memory_order_acquire)) {
+            return slot;
+        }
+        if ((i - preferred) % Slots == Slots - 1) std::this_thread::yield();
+    }
+}
+
+template<typename T, typename Policy, size_t Slots>
+bool HotTMVar<T, Policy, Slots>::tryAcquire_(size_t idx, uint64_t& version) {
+    auto& lock_table = Policy::LockTable::instance();
+
+    if constexpr (Policy::kEagerWrites) {
+        uint64_t word = lock_table.load(idx);
+        if (!lock_table.tryLock(idx, word)) return false;
+        version = Policy::LockTable::versionOf(word);
+        return true;
+    }
+    else {
+        version = 0;
+        return lock_table.tryLockByIndex(idx);
+    }
+}
+
+// 持有条带锁：执行所有已发布的操作，整批只发布一个版本
+template<typename T, typename Policy, size_t Slots>
+void HotTMVar<T, Policy, Slots>::combine_(size_t idx, uint64_t version) {
+    auto& lock_table = Policy::LockTable::instance();
+
+    std::array<Slot*, Slots> served;
+    size_t count = 0;
+
+    Node* head = this->loadHead();
+
+    try {
+        T value = head->payload;
+
+        for (Slot& slot : slots_) {
+            if (slot.state.load(std::memory_order_acquire) != kPending) continue;
+
+            try {
+                value = slot.op(slot.ctx, value);
+                slot.result->emplace(value);
+            }
+            catch (...) {
+                *slot.error = std::current_exception();
+            }
+            served[count++] = &slot;
+        }
+
+        if constexpr (Policy::kEagerWrites) {
+            // 与事务中的原地写一样，乐观读者可能正在拷贝同一个 payload
+            static_assert(std::is_trivially_copyable_v<T>, "Eager write mode requires trivially copyable payloads");
+            if (count > 0) head->payload = value;
+            lock_table.unlock(idx, count > 0 ? Policy::Clock::tick() : version);
+        }
+        else {
+            if (count > 0) {
+                Node* node = new Node(0, nullptr, std::move(value));
+                Base::committer(static_cast<Base*>(this), node, Policy::Clock::tick());
+            }
+            lock_table.unlockByIndex(idx);
+        }
+    }
+    catch (...) {
+        // 拷贝当前值或分配新版本失败：什么都没有发布。先解锁，再把异常交给所有在等的调用者
+        // (包括合并者自己的槽位)，不能直接抛出：已发布的槽位还引用着各调用者栈上的 f
+        if constexpr (Policy::kEagerWrites) {
+            lock_table.unlock(idx, version);
+        }
+        else {
+            lock_table.unlockByIndex(idx);
+        }
+
+        for (Slot& slot : slots_) {
+            if (slot.state.load(std::memory_order_acquire) != kPending) continue;
+            slot.result->reset();
+            *slot.error = std::current_exception();
+            slot.state.store(kDone, std::memory_order_release);
+        }
+        return;
+    }
+
+    if (count > 0) ChangeWaiters::changed(this);
+
+    // 新版本发布之后再通知等待者
+    for (size_t i = 0; i < count; ++i) {
+        served[i]->state.store(kDone, std::memory_order_release);
+    }
+}
+
+} // namespace Occ
+} // namespace STM
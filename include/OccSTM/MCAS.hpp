@@ -0,0 +1,125 @@
+#pragma once
+
+#include "Policy.hpp"
+#include "TMVar.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+
+namespace STM {
+
+namespace detail {
+    // 让 CasOp 的推导只依据变量类型，expected / desired 可以写 nullptr 之类的字面量
+    template<typename T>
+    struct Identity { using type = T; };
+
+    template<typename... Vars>
+    void notifyChanged(Vars*... vars) {
+        if constexpr (Occ::ChangeWaiters::kEnabled) {
+            auto& waiters = Occ::ChangeWaiters::instance();
+            if (waiters.any()) (waiters.notify(vars), ...);
+        }
+    }
+}
+
+// mcas 的一项：当 *var 等于 expected 时替换为 desired
+template<typename T, typename Policy = Occ::DefaultPolicy>
+struct CasOp {
+    Occ::TMVar<T, Policy>* var;
+    T expected;
+    T desired;
+};
+
+template<typename T, typename Policy>
+CasOp(Occ::TMVar<T, Policy>*, typename detail::Identity<T>::type, typename detail::Identity<T>::type)
+    -> CasOp<T, Policy>;
+
+
+// 多字 CAS：所有变量都等于各自的 expected 时一次性全部替换，否则什么都不做并返回 false。
+// 直接复用 Occ 的条带锁与版本链，不记读写日志；对并发事务而言等价于一个只读写这几个变量的事务。
+// 条带按索引顺序加锁，锁只在比较和挂链期间持有，调用者无需重试循环。
+//
+//   STM::mcas(STM::CasOp{&pred->next, curr, node}, STM::CasOp{&node->next, nullptr, curr});
+template<typename Policy, typename... Ts>
+bool mcas(const CasOp<Ts, Policy>&... ops) {
+    constexpr size_t N = sizeof...(Ts);
+    static_assert(N > 0, "mcas needs at least one operation");
+
+    auto& lock_table = Policy::LockTable::instance();
+
+    // 1. 条带排序去重，保证全局一致的加锁顺序
+    std::array<size_t, N> stripes{lock_table.getStripeIndex(ops.var)...};
+    std::sort(stripes.begin(), stripes.end());
+    size_t count = std::unique(stripes.begin(), stripes.end()) - stripes.begin();
+
+    if constexpr (Policy::kEagerWrites) {
+        // 原地写入时乐观读者可能正在拷贝同一个 payload
+        static_assert((std::is_trivially_copyable_v<Ts> && ...), "Eager write mode requires trivially copyable payloads");
+
+        std::array<uint64_t, N> versions{};
+        for (size_t i = 0; i < count; ++i) {
+            while (true) {
+                uint64_t word = lock_table.load(stripes[i]);
+                if (lock_table.tryLock(stripes[i], word)) {
+                    versions[i] = Policy::LockTable::versionOf(word);
+                    break;
+                }
+                std::this_thread::yield();
+            }
+        }
+
+        // 2. 比较；3. 原地写入并发布新版本
+        bool matched = ((ops.var->loadHead()->payload == ops.expected) && ...);
+        if (matched) {
+            ((ops.var->loadHead()->payload = ops.desired), ...);
+            uint64_t wv = Policy::Clock::tick();
+            for (size_t i = 0; i < count; ++i) lock_table.unlock(stripes[i], wv);
+            detail::notifyChanged(ops.var...);
+        }
+        else {
+            for (size_t i = 0; i < count; ++i) lock_table.unlock(stripes[i], versions[i]);
+        }
+        return matched;
+    }
+    else {
+        auto unlockAll = [&] {
+            for (size_t i = count; i > 0; --i) lock_table.unlockByIndex(stripes[i - 1]);
+        };
+
+        for (size_t i = 0; i < count; ++i) lock_table.lockByIndex(stripes[i]);
+
+        // 2. 比较 (持锁期间 head 不会变化，也不会被回收)；
+        // 比较成功后先在 tick 之前建好全部新版本：分配或拷贝构造抛异常时还没有任何变量被发布
+        std::array<void*, N> nodes{};
+        constexpr std::array<void (*)(void*), N> deleters{&Occ::TMVar<Ts, Policy>::deleter...};
+        size_t built = 0;
+        bool matched;
+        try {
+            matched = ((ops.var->loadHead()->payload == ops.expected) && ...);
+            if (matched) {
+                ((nodes[built] = new typename Occ::TMVar<Ts, Policy>::Node(0, nullptr, ops.desired), ++built), ...);
+            }
+        }
+        catch (...) {
+            unlockAll();
+            for (size_t i = 0; i < built; ++i) deleters[i](nodes[i]);
+            throw;
+        }
+
+        // 3. 与事务提交相同：tick 之后挂上新版本
+        if (matched) {
+            uint64_t wv = Policy::Clock::tick();
+            size_t i = 0;
+            (Occ::TMVar<Ts, Policy>::committer(ops.var, nodes[i++], wv), ...);
+        }
+
+        unlockAll();
+        if (matched) detail::notifyChanged(ops.var...);
+        return matched;
+    }
+}
+
+} // namespace STM
@@ -0,0 +1,151 @@
+#pragma once
+
+#include "STM.hpp"
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+
+namespace STM {
+namespace Occ {
+
+// 有序事务域：每个事务携带一个序号，各线程并行地推测执行，但严格按序号递增的顺序提交。
+// 轮到自己时再做一次读集验证，失败就在轮次内重做，因此结果与按序号串行执行完全一致。
+//
+// 用法 (日志回放)：
+//   OrderedDomain domain;
+//   // 多个线程各自领取日志条目 i
+//   domain.atomically(i, [&](Transaction& tx) { apply(tx, log[i]); });
+//
+// 注意：
+//   1. 从 first_seq 起的每个序号都必须被恰好执行一次，否则后续事务会一直等待。
+//   2. 等待轮次期间事务不能持有条带锁，所以只支持延迟写回的策略 (kEagerWrites == false)。
+//   3. 同理不支持准入控制 (Admission::kEnabled == false)：较晚的序号拿着令牌等轮次时，
+//      它等待的较早序号可能拿不到令牌，双方永远等待。
+class OrderedDomain {
+public:
+    explicit OrderedDomain(uint64_t first_seq = 0) noexcept : next_(first_seq) {}
+
+    OrderedDomain(const OrderedDomain&) = delete;
+    OrderedDomain& operator=(const OrderedDomain&) = delete;
+
+    // 下一个允许提交的序号
+    uint64_t nextSequence() const noexcept {
+        return next_.load(std::memory_order_acquire);
+    }
+
+    // 阻塞直到序号小于 seq 的事务全部完成
+    void waitFor(uint64_t seq) const noexcept {
+        while (!isTurn_(seq)) {
+            std::this_thread::yield();
+        }
+    }
+
+    template<typename Policy = DefaultPolicy, typename F>
+    auto atomically(uint64_t seq, F&& func);
+
+private:
+    bool isTurn_(uint64_t seq) const noexcept {
+        return next_.load(std::memory_order_acquire) == seq;
+    }
+
+    // 等到自己的轮次再提交；期间读集一旦失效就放弃，返回 false 让调用方重做
+    template<typename Policy>
+    bool commitInOrder_(BasicTransaction<Policy>& tx, uint64_t seq);
+
+    void advance_(uint64_t seq) noexcept {
+        next_.store(seq + 1, std::memory_order_release);
+    }
+
+    alignas(64) std::atomic<uint64_t> next_;
+};
+
+
+template<typename Policy>
+bool OrderedDomain::commitInOrder_(BasicTransaction<Policy>& tx, uint64_t seq) {
+    while (!isTurn_(seq)) {
+        // 更早的事务改了我读过的变量：不必等到轮次再失败
+        if (!tx.validate()) {
+            tx.abort();
+            return false;
+        }
+        std::this_thread::yield();
+    }
+
+    // 只读事务的 commit 不做验证，这里统一补一次
+    if (!tx.validate()) {
+        tx.abort();
+        return false;
+    }
+
+    if (!tx.commit()) {
+        return false;
+    }
+
+    advance_(seq);
+    return true;
+}
+
+template<typename Policy, typename F>
+auto OrderedDomain::atomically(uint64_t seq, F&& func) {
+    static_assert(!Policy::kEagerWrites, "Ordered transactions require deferred (lazy) writes");
+    static_assert(!Policy::Admission::kEnabled, "Ordered transactions cannot wait for admission tokens while holding one");
+    using Tx = BasicTransaction<Policy>;
+
+    EBRManager::instance()->enter();
+
+    Tx& tx = getLocalTransaction<Policy>();
+
+    int retry_count = 0;
+
+    while (true) {
+        // 轮次内开始的事务能看到所有更早序号的提交
+        bool began_in_turn = isTurn_(seq);
+
+        try {
+            tx.begin();
+
+            if constexpr (std::is_void_v<std::invoke_result_t<F, Tx&>>) {
+                func(tx);
+
+                if (commitInOrder_(tx, seq)) {
+                    break;
+                }
+            }
+            else {
+                auto result = func(tx);
+                if (commitInOrder_(tx, seq)) {
+                    EBRManager::instance()->leave();
+                    return result;
+                }
+            }
+        }
+        catch (const RetryException&) {
+            tx.abort();
+            retry_count++;
+            Policy::Logger::onRetry(retry_count);
+            std::this_thread::yield();
+            continue;
+        }
+        catch (...) {
+            tx.abort();
+
+            // 推测执行时的异常可能源自过期状态：轮到自己后重做一遍再下结论。
+            // 已提交 (onCommit 回调抛出) 的不能重做，直接让出序号。
+            if (!began_in_turn && !tx.committed()) {
+                waitFor(seq);
+                continue;
+            }
+
+            // 串行语义下同样会抛出：让出序号，避免后续事务永远等待
+            advance_(seq);
+            EBRManager::instance()->leave();
+            throw;
+        }
+    }
+
+    EBRManager::instance()->leave();
+}
+
+} // namespace Occ
+} // namespace STM
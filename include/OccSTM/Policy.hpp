@@ -0,0 +1,142 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+
+#include "Admission.hpp"
+#include "GlobalClock.hpp"
+#include "StripedLockTable.hpp"
+#include "VersionedLockTable.hpp"
+
+namespace STM {
+namespace Occ {
+
+// =========================================================
+// 验证策略 (Validation)
+// =========================================================
+// 由 TMVar::validate 在提交阶段回调，判断读集中的一条记录是否仍然有效。
+// current: 当前 head，expected: 读取时看到的版本，rv: 事务读版本号
+
+// kLockedReads：读取时是否需要检查条带锁 (时间戳验证依赖它，见下)
+
+// 身份验证：head 必须仍是读取时的那个节点
+struct IdentityValidation {
+    static constexpr bool kLockedReads = false;
+
+    template<typename Node>
+    static bool check(const Node* current, const Node* expected, uint64_t /*rv*/) noexcept {
+        return current == expected;
+    }
+};
+
+// 时间戳验证 (TL2 风格)：只要 head 不是“未来数据”即视为有效。
+// 只有 write_ts <= rv 的提交都已发布时才成立：提交者在 tick 之前就持有条带锁，
+// 因此读取时条带未上锁 (读前读后各查一次)，之后才上锁的提交者拿到的 wv 必然大于 rv。
+struct TimestampValidation {
+    static constexpr bool kLockedReads = true;
+
+    template<typename Node>
+    static bool check(const Node* current, const Node* /*expected*/, uint64_t rv) noexcept {
+        return current != nullptr && current->write_ts <= rv;
+    }
+};
+
+
+// =========================================================
+// 日志策略 (Logger)
+// =========================================================
+// 所有钩子都是静态内联函数，空实现会被编译器完全消除
+
+// 什么都不做
+struct NullLogger {
+    static void onBegin() noexcept {}
+    static void onCommit(size_t /*reads*/, size_t /*writes*/) noexcept {}
+    static void onAbort() noexcept {}
+    static void onRetry(int /*retry_count*/) noexcept {}
+};
+
+// 默认行为：每重试 1000 次打印一次，防止刷屏
+struct DefaultLogger : NullLogger {
+    static void onRetry(int retry_count) {
+        if (retry_count % 1000 == 0) {
+            std::cout << "[Thread " << std::this_thread::get_id()
+                    << "] Retrying... Count: " << retry_count << std::endl;
+        }
+    }
+};
+
+// 线程局部计数器，用于并排对比不同配置的提交/回滚情况
+struct CountingLogger {
+    struct Counters {
+        uint64_t begins = 0;
+        uint64_t commits = 0;
+        uint64_t aborts = 0;
+        uint64_t reads = 0;
+        uint64_t writes = 0;
+    };
+
+    static Counters& local() noexcept {
+        static thread_local Counters counters;
+        return counters;
+    }
+
+    static void onBegin() noexcept { local().begins++; }
+    static void onCommit(size_t reads, size_t writes) noexcept {
+        Counters& c = local();
+        c.commits++;
+        c.reads += reads;
+        c.writes += writes;
+    }
+    static void onAbort() noexcept { local().aborts++; }
+    static void onRetry(int /*retry_count*/) noexcept {}
+};
+
+
+// =========================================================
+// 引擎策略 (Policy)
+// =========================================================
+// Occ 引擎的全部可调参数。自定义配置时继承 DefaultPolicy 并覆盖需要的成员即可：
+//
+//   struct ShallowPolicy : STM::Occ::DefaultPolicy {
+//       static constexpr int kMaxHistory = 2;
+//       using LockTable = STM::Occ::BasicStripedLockTable<16>;
+//   };
+//
+// 不同 Policy 实例化出的 TMVar / Transaction 是互不相同的类型，
+// 各自拥有独立的锁表、描述符与线程局部事务对象。
+struct DefaultPolicy {
+    // 每个 TMVar 保留的历史版本深度
+    static constexpr int kMaxHistory = 8;
+
+    // 描述符中写集/锁集的初始容量 (读集为其 4 倍)
+    static constexpr size_t kDescriptorCapacity = 16;
+
+    // 写入方式：false 为提交时写回新版本 (Redo)；
+    // true 为首次 store 即锁条带、原地修改并记录旧值 (Undo)，LockTable 须为带版本的锁表
+    static constexpr bool kEagerWrites = false;
+
+    using LockTable = StripedLockTable;
+    using Clock = GlobalClock;
+    using Validation = IdentityValidation;
+    using Logger = DefaultLogger;
+    using Admission = NoAdmission;
+};
+
+// 低冲突、大负载场景：原地写 + Undo 日志，提交时没有写回。
+// 负载类型必须可平凡拷贝 (读者可能读到正在修改的字节，随后由版本检查丢弃)
+struct EagerPolicy : DefaultPolicy {
+    static constexpr bool kEagerWrites = true;
+    using LockTable = VersionedLockTable;
+};
+
+// 高争用场景：中止率升高时自适应地限制同时重试的写事务数 (见 AdaptiveAdmission)，
+// 当前上限等指标由 AdaptiveAdmission::metrics() 给出
+struct ThrottledPolicy : DefaultPolicy {
+    using Admission = AdaptiveAdmission;
+};
+
+} // namespace Occ
+} // namespace STM
@@ -1,10 +1,12 @@
-#pragma once 
+#pragma once
 
+#include "Policy.hpp"
 #include "TransactionDescriptor.hpp"
 #include "Transaction.hpp"
 #include "TMVar.hpp"
 #include "EBRManager/EBRManager.hpp"
-#include <iostream>
+#include "Tool/VarLayout.hpp"
+#include "Tool/TxDeadline.hpp"
 #include <sys/types.h>
 #include <thread>
 #include <type_traits>
@@ -14,31 +16,53 @@ namespace STM {
     // 将具体的实现细节（全局获取函数）移入 Occ 命名空间
     namespace Occ {
 
-        // 假设 TransactionDescriptor 已经在 STM::Occ 中定义
-        inline TransactionDescriptor& getLocalDescriptor () {
-            static thread_local TransactionDescriptor desc;
+        // 每个 Policy 拥有独立的线程局部描述符
+        template<typename Policy = DefaultPolicy>
+        inline BasicTransactionDescriptor<Policy>& getLocalDescriptor () {
+            static thread_local BasicTransactionDescriptor<Policy> desc;
             return desc;
         }
 
-        // 假设 Transaction 已经在 STM::Occ 中定义
-        inline Transaction& getLocalTransaction () {
-            static thread_local Transaction tx(&getLocalDescriptor());
+        template<typename Policy = DefaultPolicy>
+        inline BasicTransaction<Policy>& getLocalTransaction () {
+            static thread_local BasicTransaction<Policy> tx(&getLocalDescriptor<Policy>());
             return tx;
         }
     }
 
     // ================= 用户接口层 =================
 
+    // 私有化屏障：先用事务把一块数据从共享结构上摘下，再调用 privatize()，
+    // 返回后不会再有事务 (包括注定中止的旧快照读者) 访问它，可以改用 unsafeLoad / unsafeStore。
+    // 必须在 atomically 之外调用。
+    inline void privatize() {
+        EBRManager::instance()->synchronize();
+    }
+
     // 对外暴露的 Var，指向 Occ 实现
-    template<typename T>
-    using Var = Occ::TMVar<T>;
+    template<typename T, typename Policy = Occ::DefaultPolicy>
+    using Var = Occ::TMVar<T, Policy>;
+
+    // 指定内存布局的 Var：LaidOutVar<T, CacheLineLayout> 独占缓存行，LaidOutVar<T, PackedLayout> 即 Var<T>
+    template<typename T, typename Layout, typename Policy = Occ::DefaultPolicy>
+    using LaidOutVar = LaidOut<Occ::TMVar<T, Policy>, Layout>;
 
-    template<typename F>
+    // 在 ThreadHeap 上按布局构造变量，例如写热点的计数器：
+    //   auto hits = STM::makeVar<long, STM::CacheLineLayout>(0L);
+    template<typename T, typename Layout = CacheLineLayout, typename Policy = Occ::DefaultPolicy, typename... Args>
+    ThreadHeapPtr<LaidOutVar<T, Layout, Policy>> makeVar(Args&&... args) {
+        return makeOnThreadHeap<LaidOutVar<T, Layout, Policy>>(std::forward<Args>(args)...);
+    }
+
+    // 默认使用 Occ::DefaultPolicy；需要专用引擎时显式指定：
+    //   STM::atomically<MyPolicy>([&](Occ::BasicTransaction<MyPolicy>& tx) { ... });
+    template<typename Policy = Occ::DefaultPolicy, typename F>
     auto atomically(F&& func) {
+        using Tx = Occ::BasicTransaction<Policy>;
+
         EBRManager::instance()->enter();
-        
-        // 【关键修改】调用 Occ 命名空间下的函数
-        Occ::Transaction& tx = Occ::getLocalTransaction();
+
+        Tx& tx = Occ::getLocalTransaction<Policy>();
 
         int retry_count = 0; // 计数器
 
@@ -46,14 +70,13 @@ namespace STM {
             try {
                 tx.begin();
 
-                // 【关键修改】类型推导增加 Occ:: 前缀
-                if constexpr (std::is_void_v<std::invoke_result_t<F, Occ::Transaction&>>) {
+                if constexpr (std::is_void_v<std::invoke_result_t<F, Tx&>>) {
                     func(tx);
 
                     if(tx.commit()) {
                         break;
                     }
-                } 
+                }
                 else {
                     auto result = func(tx);
                     if(tx.commit()) {
@@ -61,20 +84,17 @@ namespace STM {
                         return result;
                     }
                 }
-            } 
-            // 【关键修改】捕获 Occ::RetryException
+            }
             catch(const Occ::RetryException&){
-
+                tx.abort();
                 retry_count++;
-                // 每重试 1000 次打印一下，防止刷屏
-                if (retry_count % 1000 == 0) {
-                    std::cout << "[Thread " << std::this_thread::get_id() 
-                            << "] Retrying... Count: " << retry_count << std::endl;
-                }
+                Policy::Logger::onRetry(retry_count);
                 std::this_thread::yield();
                 continue;
             }
             catch(...) {
+                // onCommit 回调抛出时事务已经提交，abort() 不会再回滚或执行 onAbort
+                tx.abort();
                 EBRManager::instance()->leave();
                 throw;
             }
@@ -82,4 +102,62 @@ namespace STM {
 
         EBRManager::instance()->leave();
     }
-}
\ No newline at end of file
+
+    // 有界重试的 atomically：每次尝试之前检查 limits，到期或被取消时不再重试，
+    // 返回 TimedOut / Cancelled (最后一次尝试已中止并执行过 onAbort 回调)。事务体抛出的其他异常照常传播。
+    //
+    //   auto r = STM::tryAtomically(STM::TxDeadline::after(2ms), [&](Occ::Transaction& tx) { return tx.load(x); });
+    //   if (!r) return reply503();
+    template<typename Policy = Occ::DefaultPolicy, typename F>
+    auto tryAtomically(const TxDeadline& limits, F&& func) {
+        using Tx = Occ::BasicTransaction<Policy>;
+        using R = std::invoke_result_t<F, Tx&>;
+
+        EBRManager::instance()->enter();
+
+        Tx& tx = Occ::getLocalTransaction<Policy>();
+
+        int retry_count = 0;
+
+        while (true) {
+            if (auto reason = limits.expired()) {
+                EBRManager::instance()->leave();
+                if constexpr (std::is_void_v<R>) return TxResult<R>{*reason};
+                else return TxResult<R>{*reason, std::nullopt};
+            }
+
+            try {
+                // 等待准入令牌时期限到期：回到循环开头返回超时/取消
+                if (!tx.begin(limits)) continue;
+
+                if constexpr (std::is_void_v<R>) {
+                    func(tx);
+
+                    if (tx.commit()) {
+                        EBRManager::instance()->leave();
+                        return TxResult<R>{TxOutcome::Committed};
+                    }
+                }
+                else {
+                    auto result = func(tx);
+                    if (tx.commit()) {
+                        EBRManager::instance()->leave();
+                        return TxResult<R>{TxOutcome::Committed, std::move(result)};
+                    }
+                }
+            }
+            catch (const Occ::RetryException&) {
+                tx.abort();
+                retry_count++;
+                Policy::Logger::onRetry(retry_count);
+                std::this_thread::yield();
+                continue;
+            }
+            catch (...) {
+                tx.abort();
+                EBRManager::instance()->leave();
+                throw;
+            }
+        }
+    }
+}
@@ -8,13 +8,15 @@
 namespace STM {
 namespace Occ {
 
-class StripedLockTable {
+// TableBits 决定条带数量 (2^TableBits)，每个条带独占一条缓存行
+template<size_t TableBits>
+class BasicStripedLockTable {
 public:
-    static constexpr size_t kTableSize = 1 << 20; 
+    static constexpr size_t kTableSize = size_t(1) << TableBits; 
     static constexpr size_t kTableMask = kTableSize - 1; 
 
-    static StripedLockTable& instance() noexcept {
-        static StripedLockTable table;
+    static BasicStripedLockTable& instance() noexcept {
+        static BasicStripedLockTable table;
         return table;
     } 
 
@@ -43,6 +45,13 @@ public:
         }
     }
 
+    // 只尝试一次，不等待
+    bool tryLockByIndex(size_t index) noexcept {
+        LockEntry& entry = locks_[index];
+        return !entry.flag.load(std::memory_order_relaxed) &&
+               !entry.flag.exchange(true, std::memory_order_acquire);
+    }
+
     void unlockByIndex(size_t index) noexcept {
         locks_[index].flag.store(false, std::memory_order_release);
     }
@@ -61,19 +70,21 @@ private:
         std::atomic<bool> flag{false};
     };
 
-    StripedLockTable() {
+    BasicStripedLockTable() {
         locks_ = new LockEntry[kTableSize];
         for (size_t i = 0; i < kTableSize; ++i) {
             locks_[i].flag.store(false, std::memory_order_relaxed);
         }
     }
 
-    ~StripedLockTable() { 
+    ~BasicStripedLockTable() { 
         delete[] locks_; 
     }
 
     LockEntry* locks_ = nullptr;
 };
 
+using StripedLockTable = BasicStripedLockTable<20>;
+
 }
 }
\ No newline at end of file
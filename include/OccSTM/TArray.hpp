@@ -0,0 +1,203 @@
+#pragma once
+
+#include "Transaction.hpp"
+#include "TMVar.hpp"
+#include "TierAlloc/ThreadHeap/ThreadHeap.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <new>
+
+namespace STM {
+namespace Occ {
+
+namespace detail {
+    // 默认每块约占一个缓存行
+    template<typename T>
+    constexpr size_t defaultBlockSize() { return std::max<size_t>(1, 64 / sizeof(T)); }
+
+    // 块的值类型：单独的类型使块的版本节点可以按下面的方式回收
+    template<typename T, size_t B>
+    struct ArrayBlock : std::array<T, B> {};
+
+    // 数组区域头，后面紧跟各块。引用计数 = 数组本身 + 尚未回收的嵌入初始节点
+    struct ArrayRegion {
+        std::atomic<size_t> refs;
+        size_t blocks;
+
+        static void unref(ArrayRegion* region) {
+            if (region->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                ThreadHeap::deallocate(region);
+            }
+        }
+    };
+
+    // 嵌在区域中的初始版本节点，带回指区域的指针
+    template<typename Block>
+    struct EmbeddedNode {
+        VersionNode<Block> node;
+        ArrayRegion* region;
+
+        explicit EmbeddedNode(ArrayRegion* r) : node(0, nullptr), region(r) {}
+    };
+
+    // 已提交的版本时间戳都大于 0，时间戳为 0 的就是嵌入区域的初始版本：
+    // 只析构，不单独释放，最后一个引用归还整个区域
+    template<typename T, size_t B>
+    struct VersionNodeRelease<ArrayBlock<T, B>> {
+        static void release(VersionNode<ArrayBlock<T, B>>* node) {
+            if (node->write_ts != 0) {
+                delete node;
+                return;
+            }
+            ArrayRegion* region = reinterpret_cast<EmbeddedNode<ArrayBlock<T, B>>*>(node)->region;
+            node->~VersionNode();
+            ArrayRegion::unref(region);
+        }
+    };
+}
+
+// 事务数组：槽位按 BlockSize 分块，每块是一个 TMVar<Block>，每块一条版本链。
+// 块头与各块的初始版本节点成对排列在一次 ThreadHeap 分配中，大小按块数计算，初始槽位因此是连续存放的；
+// 之后提交的版本照常从 ThreadHeap 单独分配。版本 (读集、验证、冲突) 以块为粒度：
+// 读取一个槽位在读集中记录所在的块；写入单个槽位记为块上的元素补丁 (见 tx.modifyAt，可平凡拷贝的 T 按字节内联)，
+// 未读过的块上的写入互不冲突，读过的块被他人改动 (哪怕是相邻槽位) 则整体验证失败。
+//
+//   STM::Occ::TArray<long, 1024> histogram;
+//   STM::atomically([&](auto& tx) { histogram.store(tx, b, histogram.load(tx, b) + 1); });
+//
+// 析构前必须保证之后不再有事务访问该数组；整个区域交给 EBR 延迟回收，可以在 atomically 内析构。
+template<typename T, typename Policy = DefaultPolicy, size_t BlockSize = detail::defaultBlockSize<T>()>
+class BasicTArray {
+public:
+    using Tx = BasicTransaction<Policy>;
+    using Block = detail::ArrayBlock<T, BlockSize>;
+
+    static constexpr size_t kBlockSize = BlockSize;
+
+    // 构造期间数组尚未发布，直接在区域中构造各块的初始版本
+    explicit BasicTArray(size_t size, const T& init = T{});
+
+    ~BasicTArray() {
+        EBRManager::instance()->retire(region_, &BasicTArray::releaseRegion_);
+    }
+
+    BasicTArray(const BasicTArray&) = delete;
+    BasicTArray& operator=(const BasicTArray&) = delete;
+
+    size_t size() const noexcept { return size_; }
+
+    T load(Tx& tx, size_t i) {
+        return withBlock_(tx, blockAt_(i / BlockSize), [i](const Block& block) { return block[i % BlockSize]; });
+    }
+
+    // 只写一个槽位：记为块上的元素补丁，不拷贝整块
+    void store(Tx& tx, size_t i, const T& val) {
+        tx.modifyAt(blockAt_(i / BlockSize), i % BlockSize, val);
+    }
+
+    // 批量读取 [first, first + count) 写入 out：每块只走一次版本链、记一条读集
+    template<typename OutIt>
+    OutIt loadRange(Tx& tx, size_t first, size_t count, OutIt out) {
+        size_t end = first + count;
+        while (first < end) {
+            size_t b = first / BlockSize;
+            size_t stop = std::min(end, (b + 1) * BlockSize);
+
+            out = withBlock_(tx, blockAt_(b), [&](const Block& block) {
+                return std::copy(block.begin() + first % BlockSize, block.begin() + (stop - b * BlockSize), out);
+            });
+            first = stop;
+        }
+        return out;
+    }
+
+    // 非事务访问：只能用于尚未发布或已私有化的数组
+    const T& unsafeLoad(size_t i) const { return blockAt_(i / BlockSize).unsafeLoad()[i % BlockSize]; }
+    void unsafeStore(size_t i, const T& val) { blockAt_(i / BlockSize).loadHead()->payload[i % BlockSize] = val; }
+
+private:
+    using BlockVar = TMVar<Block, Policy>;
+
+    struct Cell {
+        detail::EmbeddedNode<Block> initial;
+        BlockVar var;
+
+        explicit Cell(detail::ArrayRegion* region)
+            : initial(region)
+            , var(detail::AdoptNodeTag{}, &initial.node) {}
+    };
+
+    static_assert(sizeof(detail::ArrayRegion) % alignof(Cell) == 0, "TArray block alignment too large");
+
+    static Cell* cells_(detail::ArrayRegion* region) noexcept {
+        return reinterpret_cast<Cell*>(region + 1);
+    }
+
+    BlockVar& blockAt_(size_t b) const noexcept { return cells_(region_)[b].var; }
+
+    // 析构各块 (版本链连同嵌入的初始节点)，再放掉数组自己的引用
+    static void releaseRegion_(void* p) {
+        auto* region = static_cast<detail::ArrayRegion*>(p);
+        for (size_t b = 0; b < region->blocks; ++b) {
+            cells_(region)[b].var.~BlockVar();
+        }
+        detail::ArrayRegion::unref(region);
+    }
+
+    // 惰性写模式下直接引用版本节点 (不拷贝)；原地写模式下只能取值。
+    // 块上已有本事务未合并的槽位补丁时也取值：view 会把补丁物化成整块写入并产生读依赖
+    template<typename F>
+    static auto withBlock_(Tx& tx, BlockVar& var, F&& f) {
+        if constexpr (Policy::kEagerWrites) {
+            return f(static_cast<const Block&>(tx.load(var)));
+        }
+        else {
+            if (tx.hasDeferredWrite(var)) return f(static_cast<const Block&>(tx.load(var)));
+            return f(tx.view(var));
+        }
+    }
+
+    size_t size_;
+    detail::ArrayRegion* region_;
+};
+
+
+template<typename T, typename Policy, size_t BlockSize>
+BasicTArray<T, Policy, BlockSize>::BasicTArray(size_t size, const T& init) : size_(size) {
+    size_t blocks = (size + BlockSize - 1) / BlockSize;
+
+    void* mem = ThreadHeap::allocate(sizeof(detail::ArrayRegion) + blocks * sizeof(Cell));
+    if (!mem) throw std::bad_alloc();
+    region_ = new (mem) detail::ArrayRegion{{1}, 0};
+
+    try {
+        for (size_t b = 0; b < blocks; ++b) {
+            Cell* cell = new (cells_(region_) + b) Cell(region_);
+            region_->refs.fetch_add(1, std::memory_order_relaxed);
+            region_->blocks = b + 1;
+            cell->initial.node.payload.fill(init);
+        }
+    }
+    catch (...) {
+        releaseRegion_(region_);
+        throw;
+    }
+}
+
+// 定长版本
+template<typename T, size_t N, typename Policy = DefaultPolicy, size_t BlockSize = detail::defaultBlockSize<T>()>
+class TArray : public BasicTArray<T, Policy, BlockSize> {
+public:
+    explicit TArray(const T& init = T{}) : BasicTArray<T, Policy, BlockSize>(N, init) {}
+
+    static constexpr size_t size() noexcept { return N; }
+};
+
+// 运行期确定长度的版本
+template<typename T, typename Policy = DefaultPolicy>
+using TDynArray = BasicTArray<T, Policy>;
+
+} // namespace Occ
+} // namespace STM
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "Transaction.hpp"
+#include "TMVar.hpp"
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace STM {
+namespace Occ {
+
+// 分片的事务计数器：适合容器的 size 这类每次插入都要更新的全局计数。
+// add 把增量记在当前线程对应的分片上，不产生读集记录，并发的 add 之间互不冲突；
+// get 读取全部分片求和，会与之后提交的 add 产生读依赖 (精确值需要验证所有分片)。
+//
+//   STM::Occ::TCounter size;
+//   STM::atomically([&](auto& tx) { ...; size.add(tx, 1); });
+template<typename Policy = DefaultPolicy, size_t Shards = 16>
+class BasicTCounter {
+public:
+    using Tx = BasicTransaction<Policy>;
+
+    // 初值放在 0 号分片 (构造期间尚无并发访问，直接写初始版本)
+    explicit BasicTCounter(long initial = 0) {
+        shards_[0].value.loadHead()->payload = initial;
+    }
+
+    BasicTCounter(const BasicTCounter&) = delete;
+    BasicTCounter& operator=(const BasicTCounter&) = delete;
+
+    void add(Tx& tx, long delta) {
+        tx.increment(shards_[localShard_()].value, delta);
+    }
+
+    long get(Tx& tx) {
+        long sum = 0;
+        for (Shard& shard : shards_) {
+            sum += tx.load(shard.value);
+        }
+        return sum;
+    }
+
+private:
+    // 每个分片独占缓存行，避免不同线程的提交互相伪共享
+    struct alignas(64) Shard {
+        TMVar<long, Policy> value{0L};
+    };
+
+    // 线程首次使用时轮询分配分片
+    static size_t localShard_() {
+        static std::atomic<size_t> next{0};
+        static thread_local size_t shard = next.fetch_add(1, std::memory_order_relaxed) % Shards;
+        return shard;
+    }
+
+    std::array<Shard, Shards> shards_;
+};
+
+using TCounter = BasicTCounter<>;
+
+} // namespace Occ
+} // namespace STM
@@ -2,32 +2,66 @@
 
 #include <atomic>
 #include <cstdint>
+#include <thread>
+#include <type_traits>
 #include "EBRManager/EBRManager.hpp"
 #include "VersionNode.hpp"
+#include "FieldPatch.hpp"
+#include "ChangeWaiters.hpp"
+#include "Policy.hpp"
 
 namespace STM {
 namespace Occ {
 
-template<typename T>
+namespace detail {
+    // 构造标签：TMVar 直接采用调用者放置好的初始节点 (批量构造使用)
+    struct AdoptNodeTag {};
+}
+
+template<typename T, typename Policy = DefaultPolicy>
 class TMVar {
 public:
     using Node = detail::VersionNode<T>; 
+    using PolicyType = Policy;
 
     template<typename... Args>
     explicit TMVar(Args&&... args);
-    
+
+    TMVar(detail::AdoptNodeTag, Node* initial) noexcept {
+        head_.store(initial, std::memory_order_relaxed);
+    }
+
     ~TMVar();
 
     std::atomic<Node*>& getHeadRef() { return head_; }
     Node* loadHead() const;
 
-    static constexpr int MAX_HISTORY = 8;
+    // 单变量读-改-写快路径：不经过事务描述符、读写日志与 EBR 临界区。
+    // 在条带锁内用 f(旧值) 计算新值并发布，对其他事务而言等价于一个只读写本变量的事务。
+    // f 在锁内执行，应当短小；f 抛出异常时变量保持不变。返回新值。
+    template<typename F>
+    T atomicUpdate(F&& f);
+
+    // 非事务访问：只能用于已私有化的数据 (见 STM::privatize)，直接读写当前版本
+    const T& unsafeLoad() const { return loadHead()->payload; }
+    void unsafeStore(const T& val) { loadHead()->payload = val; }
+
+    static constexpr int MAX_HISTORY = Policy::kMaxHistory;
 
     // 静态生命周期管理函数
     static bool validate(const void* addr, const void* expected_head, uint64_t rv);
     static void committer(void* tmvar_ptr, void* node_ptr, uint64_t wts);
     static void deleter(void* p);
 
+    // 交换律增量：node 中存的是 delta，持锁时叠加到当前值上再挂链
+    static void deltaCommitter(void* tmvar_ptr, void* node_ptr, uint64_t wts);
+
+    // 字段级写入：node 中存的是 FieldPatch。加锁前 (patchPreparer) 拷贝当前版本，
+    // 持锁时若当前版本未变只需应用补丁，变了才重新拷贝，然后挂链
+    static void patchPreparer(void* tmvar_ptr, void* patch_ptr);
+    static void patchCommitter(void* tmvar_ptr, void* patch_ptr, uint64_t wts);
+    static void patchDeleter(void* p);
+
     TMVar(const TMVar&) = delete;    
     TMVar& operator= (const TMVar&) = delete;
 
@@ -39,65 +73,56 @@ private:
 };
 
 
-template<typename T>
+template<typename T, typename Policy>
 template<typename... Args>
-TMVar<T>::TMVar(Args&&... args) {
+TMVar<T, Policy>::TMVar(Args&&... args) {
     // 自动调用 VersionNode::operator new
     Node* init_node = new Node(0, nullptr, std::forward<Args>(args)...);
     head_.store(init_node, std::memory_order_release);
 }
 
-template<typename T>
-TMVar<T>::~TMVar() {
+template<typename T, typename Policy>
+TMVar<T, Policy>::~TMVar() {
     Node* curr = head_.load(std::memory_order_acquire);
     while (curr) {
         Node* next = curr->prev;
-        // 自动调用 VersionNode::operator delete
-        delete curr; 
+        // 默认调用 VersionNode::operator delete
+        detail::VersionNodeRelease<T>::release(curr);
         curr = next;
     }
 }
 
-template<typename T>
-typename TMVar<T>::Node* TMVar<T>::loadHead() const {
+template<typename T, typename Policy>
+typename TMVar<T, Policy>::Node* TMVar<T, Policy>::loadHead() const {
     return head_.load(std::memory_order_acquire);
 }
 
 // 辅助函数：级联回收链表
-template<typename T>
-void TMVar<T>::chainDeleter_(void* p) {
+template<typename T, typename Policy>
+void TMVar<T, Policy>::chainDeleter_(void* p) {
     auto* node = static_cast<Node*>(p);
     while (node) {
         auto* next = node->prev;
-        delete node; // 使用 VersionNode 的 delete (归还给内存池)
+        detail::VersionNodeRelease<T>::release(node); // 默认使用 VersionNode 的 delete (归还给内存池)
         node = next;
     }
 }
 
 
-template<typename T>
-bool TMVar<T>::validate(const void* addr, const void* expected_head, uint64_t rv) {
-    const auto* tmvar = static_cast<const TMVar<T>*>(addr);
+template<typename T, typename Policy>
+bool TMVar<T, Policy>::validate(const void* addr, const void* expected_head, uint64_t rv) {
+    const auto* tmvar = static_cast<const TMVar*>(addr);
     
     // 1. 获取当前 Head
     auto* current_head = tmvar->loadHead();
 
-    // 2. 【身份检查】Head 被别人改过吗？
-    if (current_head != expected_head) {
-        return false; 
-    }
-
-    // 3. 【时间检查】Head 是不是“未来数据”？
-    // if (current_head && current_head->write_ts > rv) {
-    //     return false;
-    // }
-    
-    return true;
+    // 2. 交给策略判断：身份检查 (Head 被别人改过吗？) 或 时间检查 (Head 是不是“未来数据”？)
+    return Policy::Validation::check(current_head, static_cast<const Node*>(expected_head), rv);
 }
 
-template<typename T>
-void TMVar<T>::committer(void* tmvar_ptr, void* node_ptr, uint64_t wts) {
-    auto* tmvar = static_cast<TMVar<T>*>(tmvar_ptr);
+template<typename T, typename Policy>
+void TMVar<T, Policy>::committer(void* tmvar_ptr, void* node_ptr, uint64_t wts) {
+    auto* tmvar = static_cast<TMVar*>(tmvar_ptr);
     auto* new_node = static_cast<Node*>(node_ptr);
     new_node->write_ts = wts;
     
@@ -119,12 +144,116 @@ void TMVar<T>::committer(void* tmvar_ptr, void* node_ptr, uint64_t wts) {
         Node* garbage = curr->prev;
         curr->prev = nullptr;   // 关键步骤：逻辑斩断！
 
-        EBRManager::instance()->retire(garbage, TMVar<T>::chainDeleter_);  // 现在的 garbage 才是真正安全的回收对象
+        EBRManager::instance()->retire(garbage, TMVar::chainDeleter_);  // 现在的 garbage 才是真正安全的回收对象
+    }
+}
+
+template<typename T, typename Policy>
+template<typename F>
+T TMVar<T, Policy>::atomicUpdate(F&& f) {
+    auto& lock_table = Policy::LockTable::instance();
+    size_t idx = lock_table.getStripeIndex(this);
+
+    if constexpr (Policy::kEagerWrites) {
+        // 乐观读者可能正在拷贝同一个 payload，与事务中的原地写一样要求可平凡拷贝
+        static_assert(std::is_trivially_copyable_v<T>, "Eager write mode requires trivially copyable payloads");
+
+        // 原地写模式：拿到版本锁后直接覆盖，解锁时发布新版本
+        uint64_t word;
+        while (true) {
+            word = lock_table.load(idx);
+            if (lock_table.tryLock(idx, word)) break;
+            std::this_thread::yield();
+        }
+
+        Node* head = loadHead();
+        try {
+            head->payload = f(static_cast<const T&>(head->payload));
+        }
+        catch (...) {
+            lock_table.unlock(idx, Policy::LockTable::versionOf(word));
+            throw;
+        }
+
+        T result = head->payload;
+        lock_table.unlock(idx, Policy::Clock::tick());
+        ChangeWaiters::changed(this);
+        return result;
     }
+    else {
+        // 与事务提交相同的协议：持条带锁 -> tick -> 挂链 -> 解锁
+        lock_table.lockByIndex(idx);
+
+        Node* node;
+        try {
+            node = new Node(0, nullptr, f(static_cast<const T&>(head_.load(std::memory_order_relaxed)->payload)));
+        }
+        catch (...) {
+            lock_table.unlockByIndex(idx);
+            throw;
+        }
+
+        T result = node->payload;
+        committer(this, node, Policy::Clock::tick());
+        lock_table.unlockByIndex(idx);
+        ChangeWaiters::changed(this);
+        return result;
+    }
+}
+
+template<typename T, typename Policy>
+void TMVar<T, Policy>::deltaCommitter(void* tmvar_ptr, void* node_ptr, uint64_t wts) {
+    auto* tmvar = static_cast<TMVar*>(tmvar_ptr);
+    auto* node = static_cast<Node*>(node_ptr);
+
+    const Node* current = tmvar->head_.load(std::memory_order_relaxed);
+    node->payload = static_cast<T>(current->payload + node->payload);
+
+    committer(tmvar_ptr, node_ptr, wts);
+}
+
+template<typename T, typename Policy>
+void TMVar<T, Policy>::patchPreparer(void* tmvar_ptr, void* patch_ptr) {
+    auto* tmvar = static_cast<TMVar*>(tmvar_ptr);
+    auto* patch = static_cast<detail::FieldPatch<T>*>(patch_ptr);
+
+    // 已发布的版本不再修改，锁外拷贝是安全的；提交失败重试时描述符会重建补丁记录
+    Node* head = tmvar->loadHead();
+    patch->base = head;
+    patch->base_ts = head->write_ts;
+    if (patch->base_copy) patch->base_copy->payload = head->payload;
+    else patch->base_copy = new Node(0, nullptr, head->payload);
+}
+
+template<typename T, typename Policy>
+void TMVar<T, Policy>::patchCommitter(void* tmvar_ptr, void* patch_ptr, uint64_t wts) {
+    auto* tmvar = static_cast<TMVar*>(tmvar_ptr);
+    auto* patch = static_cast<detail::FieldPatch<T>*>(patch_ptr);
+
+    // 锁内通常只写补丁涉及的字段；拷贝之后有人提交过 (或未经 patchPreparer) 才重新拷贝整个值
+    Node* head = tmvar->head_.load(std::memory_order_relaxed);
+    Node* node = patch->base_copy;
+    patch->base_copy = nullptr;
+    if (!node) {
+        node = new Node(0, nullptr, head->payload);
+    }
+    else if (patch->base != head || patch->base_ts != head->write_ts) {
+        node->payload = head->payload;
+    }
+
+    patch->applyTo(node->payload);
+    delete patch;
+
+    committer(tmvar_ptr, node, wts);
+}
+
+template<typename T, typename Policy>
+void TMVar<T, Policy>::patchDeleter(void* p) {
+    delete static_cast<detail::FieldPatch<T>*>(p);
 }
 
-template<typename T>
-void TMVar<T>::deleter(void* p) {
+template<typename T, typename Policy>
+void TMVar<T, Policy>::deleter(void* p) {
     if (!p) return;
     auto* node = static_cast<Node*>(p);
     // 这里的 delete 会触发：1. ~VersionNode() 2. VersionNode::operator delete()
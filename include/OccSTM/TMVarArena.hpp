@@ -0,0 +1,127 @@
+#pragma once
+
+#include "TMVar.hpp"
+#include "EBRManager/EBRManager.hpp"
+#include "TierAlloc/CentralHeap/CentralHeap.hpp"
+#include "TierAlloc/ThreadHeap/ChunkHeader.hpp"
+#include "TierAlloc/common/GlobalConfig.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+namespace STM {
+namespace Occ {
+
+// 批量构造大量 TMVar：变量与初始版本节点成对紧密排列在 2MB 的 BULK 块中，
+// 不逐个走 ThreadHeap，不 tick 时钟。构造出的初始版本时间戳为 0。
+//
+// 装载阶段：发布之前没有其他线程能看到这些变量，可以用 unsafeLoad / unsafeStore 直接填充；
+// 之后通过一次事务把入口 (例如 arena 指针或根节点) 写进共享变量即完成发布。
+//
+//   TMVarArena<Row> rows(n, [&](size_t i) { return Row(input[i]); });
+//   STM::atomically([&](auto& tx) { tx.store(table, &rows); });
+//
+// 析构前必须保证没有事务再访问这些变量 (同 STM::privatize 的要求)，且不能在 atomically 内析构。
+template<typename T, typename Policy = DefaultPolicy>
+class TMVarArena {
+public:
+    using Var = TMVar<T, Policy>;
+    using Node = typename Var::Node;
+
+    // 每个元素用 gen(i) 的返回值初始化
+    template<typename Gen>
+    TMVarArena(size_t count, Gen&& gen);
+
+    ~TMVarArena();
+
+    TMVarArena(const TMVarArena&) = delete;
+    TMVarArena& operator=(const TMVarArena&) = delete;
+
+    Var& operator[](size_t i) noexcept { return cellAt_(i)->var; }
+    const Var& operator[](size_t i) const noexcept { return cellAt_(i)->var; }
+
+    size_t size() const noexcept { return count_; }
+
+private:
+    struct Cell {
+        Var var;
+        Node initial;
+
+        template<typename... Args>
+        explicit Cell(Args&&... args)
+            : var(detail::AdoptNodeTag{}, &initial)
+            , initial(0, nullptr, std::forward<Args>(args)...) {}
+    };
+
+    static constexpr size_t alignUp_(size_t n, size_t a) { return (n + a - 1) / a * a; }
+
+    static constexpr size_t kCellOffset = alignUp_(sizeof(ChunkHeader), alignof(Cell));
+    static constexpr size_t kCellsPerChunk = (kChunkSize - kCellOffset) / sizeof(Cell);
+    static_assert(kCellsPerChunk > 0, "TMVarArena payload too large for a chunk");
+
+    void release_();
+    void destroyCells_();
+
+    Cell* cellAt_(size_t i) const noexcept {
+        char* base = static_cast<char*>(chunks_[i / kCellsPerChunk]);
+        return reinterpret_cast<Cell*>(base + kCellOffset) + (i % kCellsPerChunk);
+    }
+
+    size_t count_ = 0;
+    std::vector<void*> chunks_;
+};
+
+
+template<typename T, typename Policy>
+template<typename Gen>
+TMVarArena<T, Policy>::TMVarArena(size_t count, Gen&& gen) {
+    chunks_.reserve((count + kCellsPerChunk - 1) / kCellsPerChunk);
+
+    try {
+        for (size_t i = 0; i < count; ++i) {
+            if (i % kCellsPerChunk == 0) {
+                void* chunk = CentralHeap::GetInstance().fetchChunk();
+                if (!chunk) throw std::bad_alloc();
+                new (chunk) ChunkHeader(ChunkHeader::Type::BULK);
+                chunks_.push_back(chunk);
+            }
+            new (cellAt_(i)) Cell(gen(i));
+            count_ = i + 1;
+        }
+    }
+    catch (...) {
+        // 尚未发布，也没有节点被退休过，不需要 (也不能在 atomically 内) 等待宽限期
+        destroyCells_();
+        throw;
+    }
+}
+
+template<typename T, typename Policy>
+TMVarArena<T, Policy>::~TMVarArena() {
+    release_();
+}
+
+template<typename T, typename Policy>
+void TMVarArena<T, Policy>::release_() {
+    // 被历史裁剪退休的初始节点位于块内，必须在归还块之前由 EBR 回收完毕
+    EBRManager::instance()->synchronize();
+    destroyCells_();
+}
+
+template<typename T, typename Policy>
+void TMVarArena<T, Policy>::destroyCells_() {
+    // 逐个析构变量：整条版本链 (含块内初始节点) 的 payload 在这里析构；块内节点的释放是空操作
+    for (size_t i = 0; i < count_; ++i) {
+        cellAt_(i)->var.~Var();
+    }
+    count_ = 0;
+
+    for (void* chunk : chunks_) {
+        CentralHeap::GetInstance().returnChunk(chunk);
+    }
+    chunks_.clear();
+}
+
+} // namespace Occ
+} // namespace STM
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "Transaction.hpp"
+#include "TMVar.hpp"
+#include "EBRManager/EBRManager.hpp"
+#include "TierAlloc/ThreadHeap/ThreadHeap.hpp"
+#include <new>
+#include <utility>
+
+namespace STM {
+namespace Occ {
+
+// 事务化的独占指针：替代手工管理的 TMVar<Node*>。
+//   - make / reset 替换当前对象时，旧对象在提交成功后交给 EBR 延迟销毁，中止时保持不变；
+//   - 本次尝试中 make 出的新对象若最终没有提交，在中止时同样交给 EBR 销毁 (原地写模式下并发读者可能已看到它)；
+//   - release 交出所有权，不销毁。
+// 对象在 ThreadHeap 上分配，销毁方式与 EBRManager::retire(T*) 一致。
+// 读到的裸指针在事务 (EBR 临界区) 结束前有效。
+//
+//   STM::Occ::TPtr<Node> head;
+//   STM::atomically([&](STM::Occ::Transaction& tx) {
+//       Node* old = head.get(tx);
+//       head.make(tx, key, old ? old->next : nullptr);   // old 在提交后回收
+//   });
+template<typename T, typename Policy = DefaultPolicy>
+class TPtr {
+public:
+    using Tx = BasicTransaction<Policy>;
+
+    TPtr() = default;
+
+    // 非事务地构造初始对象
+    template<typename... Args>
+    explicit TPtr(std::in_place_t, Args&&... args) : ptr_(construct_(std::forward<Args>(args)...)) {}
+
+    // 析构时不能再有并发访问 (与容器析构相同)，直接销毁当前对象
+    ~TPtr() { destroy_(ptr_.unsafeLoad()); }
+
+    TPtr(const TPtr&) = delete;
+    TPtr& operator=(const TPtr&) = delete;
+
+    T* get(Tx& tx) { return tx.load(ptr_); }
+
+    // 构造新对象并替换当前对象，返回新对象
+    template<typename... Args>
+    T* make(Tx& tx, Args&&... args) {
+        T* fresh = construct_(std::forward<Args>(args)...);
+        tx.onAbort([fresh]() { EBRManager::instance()->retire(fresh); });
+        reset(tx, fresh);
+        return fresh;
+    }
+
+    // 换成 fresh (可为 nullptr) 并接管其所有权，旧对象在提交后回收。
+    // fresh 须由 ThreadHeap 分配；事务中止时不会销毁 fresh，需要这一保证时用 make。
+    void reset(Tx& tx, T* fresh = nullptr) {
+        T* old = tx.load(ptr_);
+        if (old == fresh) return;
+
+        tx.store(ptr_, fresh);
+        if (old) tx.onCommit([old]() { EBRManager::instance()->retire(old); });
+    }
+
+    // 交出当前对象的所有权并置空，提交后由调用者负责销毁
+    T* release(Tx& tx) {
+        T* old = tx.load(ptr_);
+        if (old) tx.store(ptr_, static_cast<T*>(nullptr));
+        return old;
+    }
+
+    // 非事务访问：只能用于已私有化的数据
+    T* unsafeGet() const { return ptr_.unsafeLoad(); }
+
+    TMVar<T*, Policy>& var() noexcept { return ptr_; }
+
+private:
+    template<typename... Args>
+    static T* construct_(Args&&... args) {
+        void* mem = ThreadHeap::allocate(sizeof(T));
+        if (!mem) throw std::bad_alloc();
+
+        try {
+            return new (mem) T(std::forward<Args>(args)...);
+        }
+        catch (...) {
+            ThreadHeap::deallocate(mem);
+            throw;
+        }
+    }
+
+    static void destroy_(T* p) {
+        if (!p) return;
+        p->~T();
+        ThreadHeap::deallocate(p);
+    }
+
+    TMVar<T*, Policy> ptr_{nullptr};
+};
+
+} // namespace Occ
+} // namespace STM
@@ -3,34 +3,117 @@
 #include "TransactionDescriptor.hpp"
 #include "StripedLockTable.hpp"
 #include "GlobalClock.hpp"
+#include "Policy.hpp"
 #include "TMVar.hpp"
+#include "ForkPool.hpp"
+#include "ChangeWaiters.hpp"
+#include "Tool/TxDeadline.hpp"
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cstdint>
+#include <exception>
+#include <functional>
+#include <thread>
+#include <type_traits>
 #include <vector>
+#include <utility>
 
 namespace STM {
 namespace Occ {
 
 struct RetryException : public std::exception {};
 
+// tx.retry() 抛出：本次执行放弃，等读过的变量变化后再重试
+struct WaitException : public RetryException {};
 
-class Transaction {
+
+template<typename Policy = DefaultPolicy>
+class BasicTransaction {
 public:
-    explicit Transaction(TransactionDescriptor* desc);
-    ~Transaction();
+    using PolicyType = Policy;
+    using Descriptor = BasicTransactionDescriptor<Policy>;
+
+    template<typename T>
+    using Var = TMVar<T, Policy>;
+
+    explicit BasicTransaction(Descriptor* desc);
+    ~BasicTransaction();
 
     void begin() {
-        desc_->reset();
-        desc_->setReadVersion(GlobalClock::now());
+        begin_([] { return false; });
+    }
+
+    // 与 begin 相同，但等待准入令牌 (见 Admission) 期间 limits 到期或被取消时放弃，返回 false
+    bool begin(const TxDeadline& limits) {
+        return begin_([&limits] { return limits.expired().has_value(); });
     }
 
     bool commit();
 
+    // 放弃本次尝试：丢弃写集与未提交的分配
+    void abort();
+
+    // 本次尝试是否已经提交 (onCommit 回调抛出异常时，调用方据此区分提交后的异常)
+    bool committed() const noexcept { return committed_; }
+
+    // 不提交，仅检查到目前为止的读集是否仍然有效
+    bool validate();
+
+    // 阻塞式重试：条件不满足时调用，放弃本次执行，等读过的变量被修改后再重新执行。
+    // atomically 中表现为让出 CPU 后重试；co_atomically 中协程挂起，直到读集中的变量被提交修改。
+    [[noreturn]] void retry() { throw WaitException(); }
+
+    // 结束回调，只对本次尝试有效：提交成功后依次执行 onCommit 注册的回调；
+    // 本次尝试中止 (冲突、retry、异常、期限到期) 时依次执行 onAbort 注册的回调。
+    // 回调在提交/中止完成之后运行，不要在其中使用本事务。
+    // onCommit 回调抛出的异常在提交之后传播 (其余回调不再执行)，本次尝试不会因此中止或重做。
+    void onCommit(std::function<void()> fn) { on_commit_.push_back(std::move(fn)); }
+    void onAbort(std::function<void()> fn) { on_abort_.push_back(std::move(fn)); }
+
+    template<typename T>
+    T load(TMVar<T, Policy>& var);
+
+    // 零拷贝读取：可见性与 load 相同，但返回版本节点内 payload 的引用，适合大对象。
+    // 引用在本事务提交/中止前有效 (节点由 EBR 保护，须在 atomically 内使用)；
+    // 原地写模式下值会被就地改写，不提供。
+    template<typename T>
+    const T& view(TMVar<T, Policy>& var);
+
+    // var 最近的写入是未合并的增量或字段补丁：此时 view 只能把它物化为整体写入 (拷贝整个值并产生读依赖)，
+    // 只想读值而保留补丁的调用者 (如 TArray) 应改用 load
+    template<typename T>
+    bool hasDeferredWrite(const TMVar<T, Policy>& var) const;
+
     template<typename T>
-    T load(TMVar<T>& var);
+    void store(TMVar<T, Policy>& var, const T& val);
 
+    // 右值版本：把 val 移入新版本节点
     template<typename T>
-    void store(TMVar<T>& var, const T& val);
+    void store(TMVar<T, Policy>& var, T&& val);
+
+    // 用 args 在新版本节点内直接构造值，省去临时对象和一次拷贝
+    template<typename T, typename... Args>
+    void emplace(TMVar<T, Policy>& var, Args&&... args);
+
+    // 字段级写入：只记录 "var.*field = value"，事务体内不拷贝整个对象；可平凡拷贝的字段按字节内联记录。
+    // 提交时在加锁前拷贝当前版本，持条带锁时只写入补丁字段 (拷贝之后有人提交过才在锁内重新拷贝)。未读取该变量时不产生读依赖，读取后照常按变量整体验证。
+    template<typename T, typename M, typename V>
+    void modify(TMVar<T, Policy>& var, M T::* field, V&& value);
+
+    // 元素级写入：var 的值为数组 (如 std::array) 时只记录 "value[index] = v"，其余同 modify
+    template<typename T, typename V>
+    void modifyAt(TMVar<T, Policy>& var, size_t index, V&& value);
+
+    // 通用的延迟修改：op(T&) 作为补丁记录，语义同 modify (modify 即单字段赋值的特例)。
+    // op 可能在读取时合成与提交时应用各执行一次，只能是对 T 的纯赋值，不要依赖外部状态。
+    template<typename T, typename F>
+    void patch(TMVar<T, Policy>& var, F&& op);
+
+    // 交换律增量：只记录 delta，不进入读集，提交时 (持条带锁) 加到当前值上。
+    // 并发的 increment 之间不会冲突；读取该变量才会产生读依赖。
+    template<typename T>
+    void increment(TMVar<T, Policy>& var, const T& delta);
 
     template<typename T, typename... Args>
     T* alloc(Args&&... args);
@@ -38,59 +121,354 @@ public:
     template<typename T>
     void free(T* ptr);
 
+    // 提前释放：var 不再参与提交验证，调用者保证后续逻辑不依赖它的值
+    template<typename T>
+    void release(const TMVar<T, Policy>& var);
+
+    // 弹性模式 (用于遍历搜索结构)：从现在到首次 store 之前的读取只保留最近 window 条，
+    // 路径上方无关的修改不会再导致中止；首次 store 之后的读取照常全部验证。
+    void elastic(size_t window = 2) {
+        static_assert(!Policy::kEagerWrites, "elastic mode requires deferred (lazy) writes");
+        desc_->setElastic(window);
+    }
+
+    // 并行执行互相独立的子计算 (fork-join)，每个 child 形如 void(BasicTransaction&)。
+    // 子事务共享本事务的快照，各自记日志；join 时若兄弟之间读写相交，
+    // 则丢弃全部子日志，在本事务中按参数顺序串行重做，语义等同于依次调用 child(*this)。
+    // 子任务会被重做，不要在其中做事务外的副作用。
+    // 子事务注册的 onCommit / onAbort 并入本事务；串行重做时，作废的那次执行先运行其 onAbort。
+    template<typename... Fs>
+    void fork(Fs&&... children);
+
 private:
+    template<typename Stop>
+    bool begin_(Stop&& stop);
+
+    bool commitWrites_();
+    bool commitSingle_();
+
+    void runHandlers_(bool committed);
+
+    // 准入控制：报告本次尝试的结果并归还令牌
+    void finishAdmission_(bool committed, bool wrote);
+
+    static bool siblingsConflict_(const Descriptor* children, size_t count);
+
+    // 在快照中找到可见版本并记入读集
+    template<typename T>
+    const typename TMVar<T, Policy>::Node* readSnapshot_(TMVar<T, Policy>& var);
+
+    // 找到 (或新建) var 的补丁记录；本事务已整值写过 var 时返回空，并经 whole 给出新节点中的值
+    template<typename T>
+    detail::FieldPatch<T>* patchRecord_(TMVar<T, Policy>& var, T*& whole);
+
+    // 加锁之前执行写集中各记录的 preparer
+    void prepareWrites_();
+
     bool validateReadSet();
     void lockWriteSet();
     void unlockWriteSet();
 
+    // 唤醒等待被写变量变化的协程事务
+    void notifyWaiters_();
+
+    // ---------- 原地写 (Eager) 模式 ----------
+    bool findHeldStripe_(size_t index, uint64_t& version) const;
+
+    template<typename T>
+    T loadEager_(TMVar<T, Policy>& var);
+
+    // 锁住条带并记录 Undo，返回可原地修改的当前值
+    template<typename T>
+    T& acquireEager_(TMVar<T, Policy>& var);
+
+    bool commitEager_();
+    bool validateStripes_();
+    void rollbackEager_();
+
 private:
-    TransactionDescriptor* desc_;
+    Descriptor* desc_;
+
+    std::vector<std::function<void()>> on_commit_;
+    std::vector<std::function<void()>> on_abort_;
+
+    bool needs_admission_ = false;  // 上一次尝试写过东西却中止了，下一次 begin 需要令牌
+    bool admitted_ = false;         // 当前尝试持有令牌
+    bool committed_ = false;        // 当前尝试已提交，之后的 abort() 不再生效
 };
 
+using Transaction = BasicTransaction<DefaultPolicy>;
 
+
+template<typename Policy>
 template<typename T>
-T Transaction::load(TMVar<T>& var) {
-    using Node = typename TMVar<T>::Node;
+T BasicTransaction<Policy>::load(TMVar<T, Policy>& var) {
+    using Node = typename TMVar<T, Policy>::Node;
 
-    // 1. Read-Your-Own-Writes
-    auto& wset = desc_->writeSet();
-    if (!wset.empty()) {
-        for(auto it = wset.rbegin(); it != wset.rend(); ++it) {
-            if(it->tmvar_addr == &var) return static_cast<Node*>(it->new_node)->payload;
+    if constexpr (Policy::kEagerWrites) {
+        return loadEager_(var);
+    }
+    else {
+        // 1. Read-Your-Own-Writes (fork 出的子事务沿父链继续查找)
+        //    increment 记下的增量、modify 记下的字段补丁要叠加在更早的写入或已提交值之上
+        [[maybe_unused]] bool has_delta = false;
+        [[maybe_unused]] std::conditional_t<std::is_arithmetic_v<T>, T, char> pending{};
+        [[maybe_unused]] std::vector<const detail::FieldPatch<T>*> patches;
+
+        for (const Descriptor* d = desc_; d != nullptr; d = d->parent()) {
+            auto& wset = d->writeSet();
+            for(auto it = wset.rbegin(); it != wset.rend(); ++it) {
+                if(it->tmvar_addr != &var) continue;
+
+                if constexpr (std::is_class_v<T>) {
+                    if (it->committer == &TMVar<T, Policy>::patchCommitter) {
+                        patches.push_back(static_cast<const detail::FieldPatch<T>*>(it->new_node));
+                        continue;
+                    }
+                }
+
+                const T& payload = static_cast<Node*>(it->new_node)->payload;
+                if constexpr (std::is_arithmetic_v<T>) {
+                    if (it->committer == &TMVar<T, Policy>::deltaCommitter) {
+                        pending = static_cast<T>(pending + payload);
+                        has_delta = true;
+                        continue;
+                    }
+                    if (has_delta) return static_cast<T>(payload + pending);
+                }
+                if constexpr (std::is_class_v<T>) {
+                    if (!patches.empty()) return detail::applyPatches(payload, patches);
+                }
+                return payload;
+            }
+        }
+
+        const Node* curr = readSnapshot_(var);
+
+        if constexpr (std::is_arithmetic_v<T>) {
+            if (has_delta) return static_cast<T>(curr->payload + pending);
         }
+        if constexpr (std::is_class_v<T>) {
+            if (!patches.empty()) return detail::applyPatches(curr->payload, patches);
+        }
+        return curr->payload;
     }
+}
 
-    auto* curr = var.loadHead();
+template<typename Policy>
+template<typename T>
+const T& BasicTransaction<Policy>::view(TMVar<T, Policy>& var) {
+    static_assert(!Policy::kEagerWrites, "view requires deferred (lazy) writes");
+    using Node = typename TMVar<T, Policy>::Node;
+
+    for (const Descriptor* d = desc_; d != nullptr; d = d->parent()) {
+        auto& wset = d->writeSet();
+        for (auto it = wset.rbegin(); it != wset.rend(); ++it) {
+            if (it->tmvar_addr != &var) continue;
+
+            // 未合并的增量或字段补丁没有完整的值可引用：先按普通写入物化，再引用新节点
+            if (hasDeferredWrite(var)) {
+                store(var, load(var));
+                return static_cast<Node*>(desc_->writeSet().back().new_node)->payload;
+            }
+            return static_cast<Node*>(it->new_node)->payload;
+        }
+    }
+
+    return readSnapshot_(var)->payload;
+}
 
-        
+template<typename Policy>
+template<typename T>
+bool BasicTransaction<Policy>::hasDeferredWrite(const TMVar<T, Policy>& var) const {
+    for (const Descriptor* d = desc_; d != nullptr; d = d->parent()) {
+        const auto& wset = d->writeSet();
+        for (auto it = wset.rbegin(); it != wset.rend(); ++it) {
+            if (it->tmvar_addr != &var) continue;
+
+            if constexpr (std::is_arithmetic_v<T>) {
+                return it->committer == &TMVar<T, Policy>::deltaCommitter;
+            }
+            else if constexpr (std::is_class_v<T>) {
+                return it->committer == &TMVar<T, Policy>::patchCommitter;
+            }
+            else {
+                return false;
+            }
+        }
+    }
+    return false;
+}
+
+template<typename Policy>
+template<typename T>
+const typename TMVar<T, Policy>::Node* BasicTransaction<Policy>::readSnapshot_(TMVar<T, Policy>& var) {
+    // 时间戳验证：正在提交的条带上可能有 write_ts <= RV 但尚未挂链的版本，读到的旧值无法在提交时识别
+    if constexpr (Policy::Validation::kLockedReads) {
+        if (Policy::LockTable::instance().is_locked(&var)) {
+            desc_->noteConflict(&var);
+            throw RetryException();
+        }
+    }
+
+    auto* curr = var.loadHead();
     uint64_t rv = desc_->getReadVersion();
 
     // 遍历链表找 <= RV 的版本
     while (curr != nullptr && curr->write_ts > rv) {
         curr = curr->prev;
     }
-    
+
     if(curr == nullptr) {
         // TODO：可更改为return nullptr
-        throw RetryException();   
+        desc_->noteConflict(&var);
+        throw RetryException();
+    }
+
+    if constexpr (Policy::Validation::kLockedReads) {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (Policy::LockTable::instance().is_locked(&var)) {
+            desc_->noteConflict(&var);
+            throw RetryException();
+        }
     }
 
-    desc_->addToReadSet(&var, curr, TMVar<T>::validate);
+    desc_->addToReadSet(&var, curr, TMVar<T, Policy>::validate);
+    return curr;
+}
 
-    return curr->payload;
+template<typename Policy>
+template <typename T>
+void BasicTransaction<Policy>::store(TMVar<T, Policy>& var, const T& val) {
+    emplace(var, val);
 }
 
+template<typename Policy>
 template <typename T>
-void Transaction::store(TMVar<T>& var, const T& val) {
-    using Node = typename TMVar<T>::Node;
-    Node* node = new Node(0, nullptr, val);
+void BasicTransaction<Policy>::store(TMVar<T, Policy>& var, T&& val) {
+    emplace(var, std::move(val));
+}
+
+template<typename Policy>
+template<typename T, typename... Args>
+void BasicTransaction<Policy>::emplace(TMVar<T, Policy>& var, Args&&... args) {
+    using Node = typename TMVar<T, Policy>::Node;
+
+    if constexpr (Policy::kEagerWrites) {
+        acquireEager_(var) = T(std::forward<Args>(args)...);
+    }
+    else {
+        Node* node = new Node(0, nullptr, std::forward<Args>(args)...);
+        desc_->addToWriteSet(&var, node, TMVar<T, Policy>::committer, TMVar<T, Policy>::deleter);
+    }
+}
+
+template<typename Policy>
+template<typename T, typename M, typename V>
+void BasicTransaction<Policy>::modify(TMVar<T, Policy>& var, M T::* field, V&& value) {
+    if constexpr (Policy::kEagerWrites) {
+        acquireEager_(var).*field = std::forward<V>(value);
+    }
+    else if constexpr (std::is_trivially_copyable_v<M>) {
+        // 可平凡拷贝的字段直接以字节记入补丁，不构造闭包
+        T* whole = nullptr;
+        detail::FieldPatch<T>* record = patchRecord_(var, whole);
+        if (whole) whole->*field = std::forward<V>(value);
+        else record->assign(field, M(std::forward<V>(value)));
+    }
+    else {
+        patch(var, [field, v = M(std::forward<V>(value))](T& target) { target.*field = v; });
+    }
+}
+
+template<typename Policy>
+template<typename T, typename V>
+void BasicTransaction<Policy>::modifyAt(TMVar<T, Policy>& var, size_t index, V&& value) {
+    using Elem = std::decay_t<decltype(std::declval<T&>()[index])>;
+
+    if constexpr (Policy::kEagerWrites) {
+        acquireEager_(var)[index] = std::forward<V>(value);
+    }
+    else if constexpr (std::is_trivially_copyable_v<Elem>) {
+        T* whole = nullptr;
+        detail::FieldPatch<T>* record = patchRecord_(var, whole);
+        if (whole) (*whole)[index] = std::forward<V>(value);
+        else record->assignAt(index, Elem(std::forward<V>(value)));
+    }
+    else {
+        patch(var, [index, v = Elem(std::forward<V>(value))](T& target) { target[index] = v; });
+    }
+}
+
+template<typename Policy>
+template<typename T, typename F>
+void BasicTransaction<Policy>::patch(TMVar<T, Policy>& var, F&& op) {
+    if constexpr (Policy::kEagerWrites) {
+        op(acquireEager_(var));
+    }
+    else {
+        T* whole = nullptr;
+        detail::FieldPatch<T>* record = patchRecord_(var, whole);
+        if (whole) op(*whole);
+        else record->add(std::forward<F>(op));
+    }
+}
+
+template<typename Policy>
+template<typename T>
+detail::FieldPatch<T>* BasicTransaction<Policy>::patchRecord_(TMVar<T, Policy>& var, T*& whole) {
+    using Node = typename TMVar<T, Policy>::Node;
+    using Patch = detail::FieldPatch<T>;
+
+    // 本事务已写过该变量：整值写入直接改节点 (经 whole 返回)，补丁则追加到同一条记录
+    auto& wset = desc_->writeSet();
+    for (auto it = wset.rbegin(); it != wset.rend(); ++it) {
+        if (it->tmvar_addr != &var) continue;
+
+        if (it->committer == &TMVar<T, Policy>::patchCommitter) {
+            return static_cast<Patch*>(it->new_node);
+        }
+        whole = &static_cast<Node*>(it->new_node)->payload;
+        return nullptr;
+    }
+
+    Patch* record = new Patch();
+    desc_->addToWriteSet(&var, record, TMVar<T, Policy>::patchCommitter, TMVar<T, Policy>::patchDeleter,
+                         TMVar<T, Policy>::patchPreparer);
+    return record;
+}
+
+template<typename Policy>
+template<typename T>
+void BasicTransaction<Policy>::increment(TMVar<T, Policy>& var, const T& delta) {
+    static_assert(std::is_arithmetic_v<T>, "increment requires an arithmetic payload");
+    using Node = typename TMVar<T, Policy>::Node;
+
+    if constexpr (Policy::kEagerWrites) {
+        // 原地写模式下条带本来就归自己所有，直接累加
+        T& slot = acquireEager_(var);
+        slot = static_cast<T>(slot + delta);
+    }
+    else {
+        // 已经写过 (或增过) 该变量：合并到最近的一条记录上
+        auto& wset = desc_->writeSet();
+        for (auto it = wset.rbegin(); it != wset.rend(); ++it) {
+            if (it->tmvar_addr == &var) {
+                T& payload = static_cast<Node*>(it->new_node)->payload;
+                payload = static_cast<T>(payload + delta);
+                return;
+            }
+        }
 
-    desc_->addToWriteSet(&var, node, TMVar<T>::committer, TMVar<T>::deleter);
+        Node* node = new Node(0, nullptr, delta);
+        desc_->addToWriteSet(&var, node, TMVar<T, Policy>::deltaCommitter, TMVar<T, Policy>::deleter);
+    }
 }
 
 
+template<typename Policy>
 template<typename T, typename... Args>
-T* Transaction::alloc(Args&&... args) {
+T* BasicTransaction<Policy>::alloc(Args&&... args) {
     // 使用线程堆分配内存，并做记录
     void* raw_mem = ThreadHeap::allocate(sizeof(T));
     desc_->recordAllocation(raw_mem);
@@ -98,13 +476,594 @@ T* Transaction::alloc(Args&&... args) {
 }
 
 
+template<typename Policy>
 template<typename T>
-void Transaction::free(T* ptr) {
+void BasicTransaction<Policy>::free(T* ptr) {
     if (!ptr) return;
 
     ptr->~T();
     ThreadHeap::deallocate(ptr);
 }
 
+
+template<typename Policy>
+template<typename T>
+void BasicTransaction<Policy>::release(const TMVar<T, Policy>& var) {
+    static_assert(!Policy::kEagerWrites, "release requires deferred (lazy) writes");
+    desc_->releaseRead(&var);
+}
+
+template<typename Policy>
+template<typename... Fs>
+void BasicTransaction<Policy>::fork(Fs&&... children) {
+    static_assert(!Policy::kEagerWrites, "fork requires deferred (lazy) writes");
+    constexpr size_t N = sizeof...(Fs);
+
+    if constexpr (N > 0) {
+        using Body = std::function<void(BasicTransaction&)>;
+        std::array<Body, N> bodies{Body(std::ref(children))...};
+
+        std::array<Descriptor, N> child_descs;
+        std::array<std::exception_ptr, N> errors;
+        std::array<std::vector<std::function<void()>>, N> child_commits, child_aborts;
+        std::atomic<size_t> pending{N - 1};
+
+        for (Descriptor& d : child_descs) {
+            d.setParent(desc_);
+            d.setReadVersion(desc_->getReadVersion());
+        }
+
+        // 子任务借用父线程的 EBR 临界区：父线程在 join 之前不会离开
+        auto runChild = [&](size_t i) {
+            BasicTransaction child(&child_descs[i]);
+            try {
+                bodies[i](child);
+            }
+            catch (...) {
+                errors[i] = std::current_exception();
+            }
+            child_commits[i] = std::move(child.on_commit_);
+            child_aborts[i] = std::move(child.on_abort_);
+        };
+
+        ForkPool& pool = ForkPool::instance();
+        for (size_t i = 1; i < N; ++i) {
+            pool.submit([&, i]() {
+                runChild(i);
+                pending.fetch_sub(1, std::memory_order_release);
+            });
+        }
+
+        runChild(0);
+
+        // join：等待期间帮忙执行排队任务
+        while (pending.load(std::memory_order_acquire) != 0) {
+            if (!pool.tryRunOne()) {
+                std::this_thread::yield();
+            }
+        }
+
+        // 子事务的结束回调按参数顺序并入本事务，随本事务提交或中止执行
+        auto adoptHandlers = [&]() {
+            for (size_t i = 0; i < N; ++i) {
+                for (auto& fn : child_commits[i]) on_commit_.push_back(std::move(fn));
+                for (auto& fn : child_aborts[i]) on_abort_.push_back(std::move(fn));
+            }
+        };
+
+        // 任一子任务失败 (包括 RetryException) 都交给外层的重试 / 回滚逻辑
+        for (auto& error : errors) {
+            if (error) {
+                adoptHandlers();
+                std::rethrow_exception(error);
+            }
+        }
+
+        if (siblingsConflict_(child_descs.data(), N)) {
+            // 子事务的这次执行作废，等同于中止：执行其 onAbort，丢弃 onCommit
+            for (Descriptor& d : child_descs) d.reset();
+            for (auto& handlers : child_aborts) {
+                for (auto& fn : handlers) fn();
+            }
+            (children(*this), ...);
+            return;
+        }
+
+        adoptHandlers();
+        for (Descriptor& d : child_descs) {
+            desc_->absorb(d);
+        }
+    }
+}
+
+
+// ==========================================
+// 非模版成员 (commit / validate / lock)
+// ==========================================
+
+template<typename Policy>
+BasicTransaction<Policy>::BasicTransaction(Descriptor* desc) : desc_(desc) {}
+
+template<typename Policy>
+BasicTransaction<Policy>::~BasicTransaction() {}
+
+
+template<typename Policy>
+template<typename Stop>
+bool BasicTransaction<Policy>::begin_(Stop&& stop) {
+    if constexpr (Policy::kEagerWrites) {
+        rollbackEager_();
+    }
+    desc_->reset();
+    desc_->noteConflict(nullptr);
+    desc_->setReadVersion(Policy::Clock::now());
+    on_commit_.clear();
+    on_abort_.clear();
+    committed_ = false;
+    if constexpr (Policy::Admission::kEnabled) {
+        if (needs_admission_ && !admitted_) {
+            if (!Policy::Admission::acquire(stop)) return false;
+            admitted_ = true;
+        }
+    }
+    Policy::Logger::onBegin();
+    return true;
+}
+
+template<typename Policy>
+bool BasicTransaction<Policy>::commit() {
+    // 失败路径都经过 abort()，由它执行 onAbort 回调
+    if (!commitWrites_()) return false;
+    committed_ = true;
+    finishAdmission_(true, false);
+    runHandlers_(true);
+    return true;
+}
+
+template<typename Policy>
+void BasicTransaction<Policy>::finishAdmission_(bool committed, bool wrote) {
+    if constexpr (Policy::Admission::kEnabled) {
+        if (committed) Policy::Admission::onCommit();
+        else Policy::Admission::onAbort();
+
+        needs_admission_ = !committed && wrote;
+        if (admitted_) {
+            Policy::Admission::release();
+            admitted_ = false;
+        }
+    }
+}
+
+template<typename Policy>
+void BasicTransaction<Policy>::runHandlers_(bool committed) {
+    if (on_commit_.empty() && on_abort_.empty()) return;
+
+    std::vector<std::function<void()>> handlers = std::move(committed ? on_commit_ : on_abort_);
+    on_commit_.clear();
+    on_abort_.clear();
+
+    for (auto& handler : handlers) handler();
+}
+
+template<typename Policy>
+bool BasicTransaction<Policy>::commitWrites_() {
+    if constexpr (Policy::kEagerWrites) {
+        return commitEager_();
+    }
+    else {
+        auto& wset = desc_->writeSet();
+
+        // 只读事务
+        if (wset.empty()) {
+            Policy::Logger::onCommit(desc_->readSet().size(), 0);
+            desc_->reset();
+            return true;
+        }
+
+        prepareWrites_();
+
+        // 单变量写事务：跳过锁集的排序去重
+        if (wset.size() == 1) {
+            return commitSingle_();
+        }
+
+        lockWriteSet();
+        uint64_t wv = Policy::Clock::tick();
+
+        if(!validateReadSet()) {
+            unlockWriteSet();
+            abort();
+            return false;
+        }
+
+        for (auto& entry : wset) {
+            entry.committer(entry.tmvar_addr, entry.new_node, wv);
+            entry.new_node = nullptr;
+        }
+
+        unlockWriteSet();
+        notifyWaiters_();
+
+        Policy::Logger::onCommit(desc_->readSet().size(), wset.size());
+        desc_->commitAllocations();
+        desc_->reset();
+        return true;
+    }
+}
+
+template<typename Policy>
+void BasicTransaction<Policy>::abort() {
+    // 已提交 (onCommit 回调抛出异常后外层 catch 再调用)：没有可回滚的，也不能再上报或执行 onAbort
+    if (committed_) return;
+
+    [[maybe_unused]] bool wrote = false;
+    if constexpr (Policy::kEagerWrites) {
+        wrote = !desc_->undoLog().empty();
+        rollbackEager_();
+    }
+    else {
+        wrote = !desc_->writeSet().empty();
+    }
+    Policy::Logger::onAbort();
+    desc_->reset();
+    finishAdmission_(false, wrote);
+    runHandlers_(false);
+}
+
+template<typename Policy>
+bool BasicTransaction<Policy>::commitSingle_() {
+    WriteLogEntry& entry = desc_->writeSet().front();
+    const auto& rset = desc_->readSet();
+    auto& lock_table = Policy::LockTable::instance();
+
+    size_t idx = lock_table.getStripeIndex(entry.tmvar_addr);
+    lock_table.lockByIndex(idx);
+    uint64_t wv = Policy::Clock::tick();
+
+    bool valid;
+    if (rset.empty()) {
+        valid = true;
+    }
+    else if (rset.size() == 1 && rset.front().tmvar_addr == entry.tmvar_addr) {
+        // 典型的读-改-写：条带在自己手里，只需检查 head
+        valid = rset.front().validator(rset.front().tmvar_addr, rset.front().expected_head, desc_->getReadVersion());
+        if (!valid) desc_->noteConflict(entry.tmvar_addr);
+    }
+    else {
+        desc_->lockSet().push_back(reinterpret_cast<void*>(idx));
+        valid = validateReadSet();
+    }
+
+    if (!valid) {
+        lock_table.unlockByIndex(idx);
+        abort();
+        return false;
+    }
+
+    entry.committer(entry.tmvar_addr, entry.new_node, wv);
+    entry.new_node = nullptr;
+    lock_table.unlockByIndex(idx);
+    notifyWaiters_();
+
+    Policy::Logger::onCommit(rset.size(), 1);
+    desc_->commitAllocations();
+    desc_->reset();
+    return true;
+}
+
+// 兄弟子事务之间，只要一方写过另一方读过的变量就视为冲突；
+// 只写不读的重叠按参数顺序合并，后者覆盖前者，与串行执行一致。
+template<typename Policy>
+bool BasicTransaction<Policy>::siblingsConflict_(const Descriptor* children, size_t count) {
+    std::vector<std::vector<const void*>> reads(count), writes(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        for (const auto& entry : children[i].readSet()) reads[i].push_back(entry.tmvar_addr);
+        for (const auto& entry : children[i].writeSet()) writes[i].push_back(entry.tmvar_addr);
+
+        std::sort(reads[i].begin(), reads[i].end());
+        std::sort(writes[i].begin(), writes[i].end());
+    }
+
+    auto intersects = [](const std::vector<const void*>& a, const std::vector<const void*>& b) {
+        auto ia = a.begin();
+        auto ib = b.begin();
+        while (ia != a.end() && ib != b.end()) {
+            if (*ia < *ib) ++ia;
+            else if (*ib < *ia) ++ib;
+            else return true;
+        }
+        return false;
+    };
+
+    for (size_t i = 0; i < count; ++i) {
+        for (size_t j = 0; j < count; ++j) {
+            if (i != j && intersects(writes[i], reads[j])) return true;
+        }
+    }
+    return false;
+}
+
+template<typename Policy>
+bool BasicTransaction<Policy>::validate() {
+    if constexpr (Policy::kEagerWrites) {
+        return validateStripes_();
+    }
+    else {
+        return validateReadSet();
+    }
+}
+
+template<typename Policy>
+bool BasicTransaction<Policy>::validateReadSet() {
+    uint64_t rv = desc_->getReadVersion();
+    auto& lock_table = Policy::LockTable::instance();
+    auto& locks = desc_->lockSet(); // 这里面存的是 (void*)index
+
+    for(const auto& entry : desc_->readSet()) {
+        // 前置锁检查
+        if(lock_table.is_locked(entry.tmvar_addr)){
+            // 必须先计算出地址对应的索引
+            size_t idx = lock_table.getStripeIndex(entry.tmvar_addr);
+            void* idx_ptr = reinterpret_cast<void*>(idx);
+
+            // 然后在 locks 列表中查找这个索引
+            bool locked_by_me = std::binary_search(locks.begin(), locks.end(), idx_ptr);
+
+            // 如果被锁了且不是我锁的 -> 冲突
+            if(!locked_by_me) {
+                desc_->noteConflict(entry.tmvar_addr);
+                return false;
+            }
+        }
+
+        // 身份 + 时间验证
+        if(!entry.validator(entry.tmvar_addr, entry.expected_head, rv)) {
+            desc_->noteConflict(entry.tmvar_addr);
+            return false;
+        }
+
+        // lfence：防止后面的锁检查被排到前面
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        if(lock_table.is_locked(entry.tmvar_addr)){
+            size_t idx = lock_table.getStripeIndex(entry.tmvar_addr);
+            void* idx_ptr = reinterpret_cast<void*>(idx);
+
+            bool locked_by_me = std::binary_search(locks.begin(), locks.end(), idx_ptr);
+            if(!locked_by_me) {
+                desc_->noteConflict(entry.tmvar_addr);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+
+template<typename Policy>
+void BasicTransaction<Policy>::lockWriteSet() {
+    auto& wset = desc_->writeSet();
+    auto& locks = desc_->lockSet();
+
+    locks.clear();
+
+    auto& lock_table = Policy::LockTable::instance();
+
+    // 1. 直接填入 locks
+    for(auto& entry : wset) {
+        size_t idx = lock_table.getStripeIndex(entry.tmvar_addr);
+        locks.push_back(reinterpret_cast<void*>(idx));
+    }
+
+    // 2. 在 locks 上排序去重
+    std::sort(locks.begin(), locks.end());
+    auto last = std::unique(locks.begin(), locks.end());
+    locks.erase(last, locks.end());
+
+    // 3. 遍历加锁
+    for(void* ptr_idx : locks) {
+        size_t idx = reinterpret_cast<size_t>(ptr_idx);
+        lock_table.lockByIndex(idx);
+    }
+}
+
+template<typename Policy>
+void BasicTransaction<Policy>::prepareWrites_() {
+    for (WriteLogEntry& entry : desc_->writeSet()) {
+        if (entry.preparer) entry.preparer(entry.tmvar_addr, entry.new_node);
+    }
+}
+
+template<typename Policy>
+void BasicTransaction<Policy>::notifyWaiters_() {
+    if constexpr (ChangeWaiters::kEnabled) {
+        auto& waiters = ChangeWaiters::instance();
+        if (!waiters.any()) return;
+
+        if constexpr (Policy::kEagerWrites) {
+            for (const UndoLogEntry& entry : desc_->undoLog()) waiters.notify(entry.tmvar_addr);
+        }
+        else {
+            for (const WriteLogEntry& entry : desc_->writeSet()) waiters.notify(entry.tmvar_addr);
+        }
+    }
+}
+
+template<typename Policy>
+void BasicTransaction<Policy>::unlockWriteSet() {
+    auto& locks = desc_->lockSet();
+    auto& lock_table = Policy::LockTable::instance();
+
+    for (auto it = locks.rbegin(); it != locks.rend(); ++it) {
+        size_t idx = reinterpret_cast<size_t>(*it);
+        lock_table.unlockByIndex(idx);
+    }
+    locks.clear();
+}
+
+// ==========================================
+// 原地写 (Eager / Undo-log) 模式
+// ==========================================
+// 首次 store 时锁住条带并原地修改，旧值进入 Undo 日志；提交只需发布新版本并解锁。
+// 读者以条带锁字做 seqlock 检查，读集记录条带版本，提交时按版本验证。
+// 下面的非模板成员也会随默认配置显式实例化，因此函数体放在 if constexpr 中。
+
+template<typename Policy>
+bool BasicTransaction<Policy>::findHeldStripe_(size_t index, uint64_t& version) const {
+    for (const HeldStripe& held : desc_->heldStripes()) {
+        if (held.index == index) {
+            version = held.version;
+            return true;
+        }
+    }
+    return false;
+}
+
+template<typename Policy>
+template<typename T>
+T BasicTransaction<Policy>::loadEager_(TMVar<T, Policy>& var) {
+    static_assert(std::is_trivially_copyable_v<T>, "Eager write mode requires trivially copyable payloads");
+
+    auto& lock_table = Policy::LockTable::instance();
+    size_t idx = lock_table.getStripeIndex(&var);
+
+    // 条带在自己手里：直接读 (可能是本事务刚写入的值)
+    uint64_t held_version;
+    if (findHeldStripe_(idx, held_version)) {
+        return var.loadHead()->payload;
+    }
+
+    // 上锁中或比快照新：无法读到一致的旧值
+    uint64_t before = lock_table.load(idx);
+    if (Policy::LockTable::isLocked(before) ||
+        Policy::LockTable::versionOf(before) > desc_->getReadVersion()) {
+        throw RetryException();
+    }
+
+    T val = var.loadHead()->payload;
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (lock_table.load(idx) != before) {
+        throw RetryException();
+    }
+
+    desc_->stripeReads().push_back({idx, Policy::LockTable::versionOf(before)});
+    return val;
+}
+
+template<typename Policy>
+template<typename T>
+T& BasicTransaction<Policy>::acquireEager_(TMVar<T, Policy>& var) {
+    static_assert(std::is_trivially_copyable_v<T>, "Eager write mode requires trivially copyable payloads");
+
+    auto& lock_table = Policy::LockTable::instance();
+    size_t idx = lock_table.getStripeIndex(&var);
+
+    // 1. 遇到即加锁 (encounter-time locking)，失败直接重试，不会死锁
+    uint64_t held_version;
+    if (!findHeldStripe_(idx, held_version)) {
+        uint64_t word = lock_table.load(idx);
+        if (Policy::LockTable::versionOf(word) > desc_->getReadVersion() ||
+            !lock_table.tryLock(idx, word)) {
+            throw RetryException();
+        }
+        desc_->heldStripes().push_back({idx, Policy::LockTable::versionOf(word)});
+    }
+
+    // 2. 每个变量只在首次写入时保存旧值 (按字节拷入描述符的 undo 缓冲区)
+    desc_->logUndo(&var, &var.loadHead()->payload, sizeof(T));
+
+    // 3. 交给调用者原地修改
+    return var.loadHead()->payload;
+}
+
+template<typename Policy>
+bool BasicTransaction<Policy>::commitEager_() {
+    if constexpr (!Policy::kEagerWrites) {
+        return false;
+    }
+    else {
+        auto& held = desc_->heldStripes();
+
+        // 只读事务：每次读取都已确认不晚于快照
+        if (held.empty()) {
+            Policy::Logger::onCommit(desc_->stripeReads().size(), 0);
+            desc_->reset();
+            return true;
+        }
+
+        uint64_t wv = Policy::Clock::tick();
+
+        // 期间没有别人提交时可以跳过验证
+        if (wv != desc_->getReadVersion() + 1 && !validateStripes_()) {
+            abort();
+            return false;
+        }
+
+        // 没有写回：发布新版本即可
+        auto& lock_table = Policy::LockTable::instance();
+        for (const HeldStripe& stripe : held) {
+            lock_table.unlock(stripe.index, wv);
+        }
+        held.clear();
+        notifyWaiters_();
+
+        Policy::Logger::onCommit(desc_->stripeReads().size(), desc_->undoLog().size());
+        desc_->commitAllocations();
+        desc_->reset();
+        return true;
+    }
+}
+
+template<typename Policy>
+bool BasicTransaction<Policy>::validateStripes_() {
+    if constexpr (!Policy::kEagerWrites) {
+        return false;
+    }
+    else {
+        auto& lock_table = Policy::LockTable::instance();
+
+        for (const StripeReadEntry& entry : desc_->stripeReads()) {
+            uint64_t word = lock_table.load(entry.index);
+
+            if (Policy::LockTable::isLocked(word)) {
+                // 只有自己持有、且加锁前的版本就是读到的版本才有效
+                uint64_t held_version;
+                if (!findHeldStripe_(entry.index, held_version) || held_version != entry.version) {
+                    return false;
+                }
+            }
+            else if (Policy::LockTable::versionOf(word) != entry.version) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+template<typename Policy>
+void BasicTransaction<Policy>::rollbackEager_() {
+    if constexpr (Policy::kEagerWrites) {
+        // 先逆序恢复旧值，再以新版本解锁：乐观读者可能在读前后两次锁字之间拷贝了未提交的值，
+        // 换回原版本会让它的检查通过，新版本则迫使它重试
+        desc_->restoreUndo();
+
+        // 没有持锁 (只读事务、每次 begin) 就不碰全局时钟
+        auto& held = desc_->heldStripes();
+        if (held.empty()) return;
+
+        auto& lock_table = Policy::LockTable::instance();
+        uint64_t version = Policy::Clock::tick();
+        for (const HeldStripe& stripe : held) {
+            lock_table.unlock(stripe.index, version);
+        }
+        held.clear();
+    }
+}
+
+// 默认配置在 Transaction.cpp 中显式实例化
+extern template class BasicTransaction<DefaultPolicy>;
+
 } // namespace Occ
-} // namespace STM
\ No newline at end of file
+} // namespace STM
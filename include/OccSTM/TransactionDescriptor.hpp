@@ -1,8 +1,10 @@
 #pragma once
 
 #include "ThreadHeap/ThreadHeap.hpp"
+#include "Policy.hpp"
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <vector>
 
 namespace STM {
@@ -26,9 +28,91 @@ struct WriteLogEntry {
 
     using Deleter = void (*)(void* node);
     Deleter deleter;
+
+    // 可选：加锁之前调用，把能在锁外做的工作 (如拷贝当前版本) 提前做掉
+    using Preparer = void (*)(void* tmvar, void* node);
+    Preparer preparer = nullptr;
+};
+
+// ---------- 原地写 (Eager) 模式使用的日志 ----------
+
+// 读到的条带及其版本
+struct StripeReadEntry {
+    size_t index;
+    uint64_t version;
+};
+
+// 本事务持有的条带锁，version 为加锁前的版本 (回滚时恢复)
+struct HeldStripe {
+    size_t index;
+    uint64_t version;
+};
+
+// Undo 日志：首次写入前的值按字节存在描述符的 undo 缓冲区 [offset, offset + size) 中，
+// payload 是变量当前版本值的地址 (原地写模式下版本节点不变，payload 可平凡拷贝)
+struct UndoLogEntry {
+    void* tmvar_addr;
+    void* payload;
+    size_t offset;
+    size_t size;
 };
 
-class TransactionDescriptor {
+// 地址集合：开放寻址 + 线性探测，用于 "该变量是否已记录过旧值" 的判断。
+// 只在单个描述符内使用；clear 只清理用过的槽，不随容量增长
+class AddressSet {
+public:
+    // 插入成功 (此前不存在) 返回 true
+    bool insert(const void* addr) {
+        if ((used_.size() + 1) * 2 > slots_.size()) grow_();
+
+        size_t mask = slots_.size() - 1;
+        for (size_t i = hash_(addr) & mask;; i = (i + 1) & mask) {
+            if (slots_[i] == addr) return false;
+            if (slots_[i] == nullptr) {
+                slots_[i] = addr;
+                used_.push_back(i);
+                return true;
+            }
+        }
+    }
+
+    void clear() {
+        for (size_t i : used_) slots_[i] = nullptr;
+        used_.clear();
+    }
+
+    void reserve(size_t n) {
+        while (slots_.size() < n * 2) grow_();
+    }
+
+private:
+    static size_t hash_(const void* addr) noexcept {
+        // 变量地址低位对齐为零，乘法散列后取高位
+        return static_cast<size_t>((reinterpret_cast<uintptr_t>(addr) * 0x9E3779B97F4A7C15ull) >> 32);
+    }
+
+    void grow_() {
+        std::vector<const void*> old;
+        old.swap(slots_);
+        slots_.assign(old.empty() ? 16 : old.size() * 2, nullptr);
+
+        size_t mask = slots_.size() - 1;
+        for (size_t& slot : used_) {
+            const void* addr = old[slot];
+            size_t i = hash_(addr) & mask;
+            while (slots_[i] != nullptr) i = (i + 1) & mask;
+            slots_[i] = addr;
+            slot = i;
+        }
+    }
+
+    std::vector<const void*> slots_;
+    std::vector<size_t> used_;
+};
+
+
+template<typename Policy>
+class BasicTransactionDescriptor {
 public:
     enum class State {
         Active,
@@ -36,15 +120,23 @@ public:
         Aborted
     };
 
-    static constexpr size_t kDefaultCapacity = 16;
+    static constexpr size_t kDefaultCapacity = Policy::kDescriptorCapacity;
 
-    TransactionDescriptor() {
+    BasicTransactionDescriptor() {
         read_set_.reserve(kDefaultCapacity * 4);
         write_set_.reserve(kDefaultCapacity);
         lock_set_.reserve(kDefaultCapacity); 
+
+        if constexpr (Policy::kEagerWrites) {
+            stripe_reads_.reserve(kDefaultCapacity * 4);
+            held_stripes_.reserve(kDefaultCapacity);
+            undo_log_.reserve(kDefaultCapacity);
+            undo_bytes_.reserve(kDefaultCapacity * 64);
+            undo_index_.reserve(kDefaultCapacity);
+        }
     }
 
-    ~TransactionDescriptor() {
+    ~BasicTransactionDescriptor() {
         reset(); 
     }
 
@@ -56,10 +148,19 @@ public:
 
         state_ = State::Active;
         read_version_ = 0;
+        elastic_window_ = 0;
+        elastic_base_ = 0;
 
         read_set_.clear();
         lock_set_.clear(); 
         clearWriteSet_();
+
+        // Undo 日志中的旧值此时已无用 (已提交或已恢复)
+        undo_log_.clear();
+        undo_bytes_.clear();
+        undo_index_.clear();
+        stripe_reads_.clear();
+        held_stripes_.clear();
     }
 
     void setReadVersion(uint64_t rv) { read_version_ = rv; }
@@ -67,10 +168,38 @@ public:
 
     void addToReadSet(const void* addr, const void* head, ReadLogEntry::Validator v) {
         read_set_.push_back({addr, head, v});
+
+        // 弹性阶段 (首次写入之前)：只保留最近 elastic_window_ 条读取
+        if (elastic_window_ != 0 && write_set_.empty() &&
+            read_set_.size() - elastic_base_ > elastic_window_) {
+            read_set_.erase(read_set_.begin() + elastic_base_);
+        }
+    }
+
+    // 开启弹性模式：此前的读取照常保留，此后到首次写入前的读取只保留滑动窗口
+    void setElastic(size_t window) {
+        elastic_window_ = window;
+        elastic_base_ = read_set_.size();
+    }
+
+    // 提前释放：从读集中移除该变量的所有记录
+    void releaseRead(const void* addr) {
+        size_t kept = 0;
+        size_t base = elastic_base_;
+        for (size_t i = 0; i < read_set_.size(); ++i) {
+            if (read_set_[i].tmvar_addr == addr) {
+                if (i < elastic_base_) --base;
+                continue;
+            }
+            read_set_[kept++] = read_set_[i];
+        }
+        read_set_.resize(kept);
+        elastic_base_ = base;
     }
 
-    void addToWriteSet(void* addr, void* new_node, WriteLogEntry::Committer c, WriteLogEntry::Deleter d) {
-        write_set_.push_back({addr, new_node, c, d});
+    void addToWriteSet(void* addr, void* new_node, WriteLogEntry::Committer c, WriteLogEntry::Deleter d,
+                       WriteLogEntry::Preparer p = nullptr) {
+        write_set_.push_back({addr, new_node, c, d, p});
     }
 
     void recordAllocation(void* ptr) {
@@ -81,10 +210,61 @@ public:
         allocated_ptrs_.clear();
     }
 
+    // ---------- fork 子事务 ----------
+    // 子事务读取时还要看父事务 (及更外层) 的写集
+    void setParent(const BasicTransactionDescriptor* parent) { parent_ = parent; }
+    const BasicTransactionDescriptor* parent() const { return parent_; }
+
+    // join 时把子事务的日志并入本事务，新节点与分配的所有权一并转移
+    void absorb(BasicTransactionDescriptor& child) {
+        read_set_.insert(read_set_.end(), child.read_set_.begin(), child.read_set_.end());
+
+        for (WriteLogEntry& entry : child.write_set_) {
+            write_set_.push_back(entry);
+            entry.new_node = nullptr;
+        }
+
+        allocated_ptrs_.insert(allocated_ptrs_.end(), child.allocated_ptrs_.begin(), child.allocated_ptrs_.end());
+        child.allocated_ptrs_.clear();
+
+        child.reset();
+    }
+
     const std::vector<ReadLogEntry>& readSet() const { return read_set_; }
     std::vector<WriteLogEntry>& writeSet() { return write_set_; }
+    const std::vector<WriteLogEntry>& writeSet() const { return write_set_; }
     std::vector<void*>& lockSet() { return lock_set_; }
 
+    std::vector<StripeReadEntry>& stripeReads() { return stripe_reads_; }
+    std::vector<HeldStripe>& heldStripes() { return held_stripes_; }
+    const std::vector<UndoLogEntry>& undoLog() const { return undo_log_; }
+
+    // 首次写入 addr 时把 payload 的 size 字节存入 undo 缓冲区；已记录过则什么都不做
+    void logUndo(void* addr, void* payload, size_t size) {
+        if (!undo_index_.insert(addr)) return;
+
+        size_t offset = undo_bytes_.size();
+        const auto* bytes = static_cast<const unsigned char*>(payload);
+        undo_bytes_.insert(undo_bytes_.end(), bytes, bytes + size);
+        undo_log_.push_back({addr, payload, offset, size});
+    }
+
+    // 逆序把旧值拷回各变量 (调用者仍持有这些变量的条带锁)
+    void restoreUndo() {
+        for (auto it = undo_log_.rbegin(); it != undo_log_.rend(); ++it) {
+            std::memcpy(it->payload, undo_bytes_.data() + it->offset, it->size);
+        }
+    }
+
+    // 冲突提示：最近一次验证失败时出问题的变量地址。
+    // 提交失败会 reset 描述符，提示不随之清除，由调度器 (见 TxExecutor) 在失败后取走
+    void noteConflict(const void* addr) { conflict_hint_ = addr; }
+    const void* takeConflict() {
+        const void* addr = conflict_hint_;
+        conflict_hint_ = nullptr;
+        return addr;
+    }
+
 private:
     void clearWriteSet_() {
         for(WriteLogEntry& entry : write_set_) {
@@ -98,12 +278,24 @@ private:
 private:
     State state_{State::Active};
     uint64_t read_version_{0};
+    const BasicTransactionDescriptor* parent_ = nullptr;
+    size_t elastic_window_ = 0;
+    size_t elastic_base_ = 0;
+    const void* conflict_hint_ = nullptr;
     std::vector<ReadLogEntry> read_set_;
     std::vector<WriteLogEntry> write_set_;
     std::vector<void*> lock_set_; 
 
+    std::vector<StripeReadEntry> stripe_reads_;
+    std::vector<HeldStripe> held_stripes_;
+    std::vector<UndoLogEntry> undo_log_;
+    std::vector<unsigned char> undo_bytes_;
+    AddressSet undo_index_;
+
     std::vector<void*> allocated_ptrs_; 
 };
 
+using TransactionDescriptor = BasicTransactionDescriptor<DefaultPolicy>;
+
 } // namespace Occ
 } // namespace STM
\ No newline at end of file
@@ -0,0 +1,180 @@
+#pragma once
+
+#include "STM.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace STM {
+namespace Occ {
+
+// 事务任务执行器：submit(f) 把事务体 f(Tx&) 交给工作线程执行，返回 std::future。
+// 每个工作线程一个双端队列，自己从尾部取 (LIFO)，空闲时从其他线程的头部窃取。
+//
+// 冲突感知调度 (steal-on-abort)：任务中止时取出描述符记下的冲突变量，查找该变量的"属主"工作线程。
+// 属主是最近一个在该变量上中止、并认领了它的工作线程 (不一定是造成这次中止的提交者)。
+// 属主是别的线程时，任务被移到属主的队列尾部，与其他在同一变量上中止的任务集中到一个线程上串行执行；
+// 没有属主时由当前线程认领。属主的本地队列一旦取空，它认领的所有变量随即失效，下一个中止者重新认领。
+// 每个任务最多迁移一次，之后在原地重试。
+//
+//   STM::Occ::TxExecutor exec(4);
+//   auto f = exec.submit([&](STM::Occ::Transaction& tx) { return tx.load(x) + 1; });
+//   f.get();
+//
+// 事务体会被重复执行 (可能在不同线程上)，要求与 atomically 相同：不要有事务外的副作用，
+// 也不要在其中再调用 atomically。事务体需要可拷贝 (存放在 std::function 中)。
+class TxExecutor {
+public:
+    explicit TxExecutor(size_t workers = defaultWorkerCount(), bool conflict_aware = true);
+
+    // 执行完所有已提交的任务后才返回
+    ~TxExecutor();
+
+    TxExecutor(const TxExecutor&) = delete;
+    TxExecutor& operator=(const TxExecutor&) = delete;
+
+    template<typename Policy = DefaultPolicy, typename F>
+    auto submit(F&& func) -> std::future<std::invoke_result_t<F, BasicTransaction<Policy>&>>;
+
+    // 提交一个普通任务 (不是事务体，只执行一次)。协程事务 (OccSTM/Coroutine.hpp) 借此在工作线程上推进
+    void post(std::function<void()> fn);
+
+    size_t workerCount() const noexcept { return workers_.size(); }
+
+    // 因冲突被迁移到其他工作线程的任务数
+    size_t migrations() const noexcept { return migrations_.load(std::memory_order_relaxed); }
+
+    static size_t defaultWorkerCount();
+
+private:
+    // 执行一次尝试：完成 (提交成功或异常已交给 future) 返回 true；中止返回 false 并给出冲突提示
+    using Attempt = std::function<bool(const void*& conflict)>;
+
+    struct Task {
+        Attempt attempt;
+        bool migrated = false;
+    };
+
+    struct alignas(64) Worker {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+        // 本地队列每取空一次加一，使此前的认领全部失效
+        std::atomic<uint32_t> generation{0};
+    };
+
+    // 属主表的每个槽是一个字：地址指纹 (高 32 位) | 工作线程编号 + 1 (16 位) | 认领时的 generation (低 16 位)，
+    // 0 表示空。指纹不同的变量 (哈希到同一槽) 互不影响，后认领者覆盖先认领者
+    static constexpr size_t kOwnerSlots = 1024;
+
+    static uint64_t packOwner_(uint32_t fingerprint, size_t worker, uint32_t generation) noexcept {
+        return (uint64_t(fingerprint) << 32) | (uint64_t(worker + 1) << 16) | (generation & 0xffff);
+    }
+
+    template<typename Policy, typename F, typename R>
+    static bool attemptOnce_(F& func, std::promise<R>& promise, const void*& conflict);
+
+    size_t pickWorker_();
+
+    // 中止的任务在冲突变量上的属主 (没有有效属主时返回 false 并让 w 认领)
+    bool findOwner_(const void* conflict, size_t w, size_t& owner);
+
+    void push_(size_t w, Task task);
+    bool popLocal_(size_t w, Task& task);
+    bool steal_(size_t w, Task& task);
+    void run_(size_t w, Task task);
+    void workerLoop_(size_t w);
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::vector<std::thread> threads_;
+    bool conflict_aware_;
+
+    // 冲突变量 -> 属主工作线程 (见 packOwner_)
+    std::unique_ptr<std::atomic<uint64_t>[]> owners_;
+
+    std::mutex sleep_mutex_;
+    std::condition_variable cv_;
+    std::atomic<size_t> pending_{0};
+    bool stop_ = false;
+
+    std::atomic<size_t> next_{0};
+    std::atomic<size_t> migrations_{0};
+};
+
+
+template<typename Policy, typename F>
+auto TxExecutor::submit(F&& func) -> std::future<std::invoke_result_t<F, BasicTransaction<Policy>&>> {
+    using R = std::invoke_result_t<F, BasicTransaction<Policy>&>;
+
+    auto promise = std::make_shared<std::promise<R>>();
+    std::future<R> future = promise->get_future();
+
+    Task task;
+    task.attempt = [promise, body = std::decay_t<F>(std::forward<F>(func))](const void*& conflict) mutable {
+        return attemptOnce_<Policy>(body, *promise, conflict);
+    };
+
+    push_(pickWorker_(), std::move(task));
+    return future;
+}
+
+// 与 atomically 的单次循环相同，只是不在内部重试
+template<typename Policy, typename F, typename R>
+bool TxExecutor::attemptOnce_(F& func, std::promise<R>& promise, const void*& conflict) {
+    using Tx = BasicTransaction<Policy>;
+
+    EBRManager::instance()->enter();
+    Tx& tx = getLocalTransaction<Policy>();
+
+    bool committed = false;
+    std::conditional_t<std::is_void_v<R>, char, std::optional<R>> result{};
+
+    try {
+        tx.begin();
+
+        if constexpr (std::is_void_v<R>) {
+            func(tx);
+        }
+        else {
+            result.emplace(func(tx));
+        }
+        committed = tx.commit();
+    }
+    catch (const RetryException&) {
+        tx.abort();
+    }
+    catch (...) {
+        tx.abort();
+        EBRManager::instance()->leave();
+        promise.set_exception(std::current_exception());
+        return true;
+    }
+
+    EBRManager::instance()->leave();
+
+    if (!committed) {
+        conflict = getLocalDescriptor<Policy>().takeConflict();
+        return false;
+    }
+
+    if constexpr (std::is_void_v<R>) {
+        promise.set_value();
+    }
+    else {
+        promise.set_value(std::move(*result));
+    }
+    return true;
+}
+
+} // namespace Occ
+} // namespace STM
@@ -28,6 +28,12 @@ struct VersionNode {
     static void operator delete(void *p) { ThreadHeap::deallocate(p); }
 };
 
+// 已提交版本链上节点的回收方式，可按 payload 类型特化 (见 TArray：块的初始版本嵌在数组区域中，不单独释放)
+template<typename T>
+struct VersionNodeRelease {
+    static void release(VersionNode<T>* node) { delete node; }
+};
+
 } // namespace detail
 
 } // namespace Occ
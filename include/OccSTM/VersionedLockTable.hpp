@@ -0,0 +1,68 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+
+namespace STM {
+namespace Occ {
+
+// 带版本号的条带锁表，供原地写 (Eager) 模式使用。
+// 每个条带一个 64 位字：最低位是锁位，其余位是最近一次提交的时间戳。
+// 读者按 seqlock 的方式使用：读前读后各取一次锁字，两次相同且未上锁即读到一致的值。
+template<size_t TableBits>
+class BasicVersionedLockTable {
+public:
+    static constexpr size_t kTableSize = size_t(1) << TableBits;
+    static constexpr size_t kTableMask = kTableSize - 1;
+
+    static BasicVersionedLockTable& instance() noexcept {
+        static BasicVersionedLockTable table;
+        return table;
+    }
+
+    size_t getStripeIndex(const void* addr) const noexcept {
+        return std::hash<const void*>{}(addr) & kTableMask;
+    }
+
+    uint64_t load(size_t index) const noexcept {
+        return locks_[index].word.load(std::memory_order_acquire);
+    }
+
+    // 只在锁字仍等于 expected (且未上锁) 时加锁，失败立即返回
+    bool tryLock(size_t index, uint64_t expected) noexcept {
+        if (isLocked(expected)) return false;
+        return locks_[index].word.compare_exchange_strong(
+            expected, expected | kLockBit, std::memory_order_acq_rel, std::memory_order_relaxed);
+    }
+
+    // 解锁并发布新版本。未修改数据时可传入原版本；修改过 (包括已回滚的原地写) 必须传入新版本
+    void unlock(size_t index, uint64_t version) noexcept {
+        locks_[index].word.store(version << 1, std::memory_order_release);
+    }
+
+    static bool isLocked(uint64_t word) noexcept { return (word & kLockBit) != 0; }
+    static uint64_t versionOf(uint64_t word) noexcept { return word >> 1; }
+
+private:
+    static constexpr uint64_t kLockBit = 1;
+
+    struct alignas(64) LockEntry {
+        std::atomic<uint64_t> word{0};
+    };
+
+    BasicVersionedLockTable() {
+        locks_ = new LockEntry[kTableSize];
+    }
+
+    ~BasicVersionedLockTable() {
+        delete[] locks_;
+    }
+
+    LockEntry* locks_ = nullptr;
+};
+
+using VersionedLockTable = BasicVersionedLockTable<20>;
+
+}
+}
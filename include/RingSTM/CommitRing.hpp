@@ -0,0 +1,111 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <immintrin.h>
+
+#include "Signature.hpp"
+#include "TierAlloc/common/GlobalConfig.hpp"
+
+namespace STM {
+namespace Ring {
+
+// 全局提交环：每个写事务提交时占用一个槽位，发布自己的写签名。
+// 槽位序号即提交时间戳，写回按序号顺序完成。
+class CommitRing {
+public:
+    static constexpr size_t kRingSize = 1024;
+    static constexpr size_t kSignatureBits = 1024;
+
+    using Sig = Signature<kSignatureBits>;
+
+    // ts 的特殊值：槽位正在被改写
+    static constexpr uint64_t kWriting = ~uint64_t(0);
+
+    static CommitRing& instance() noexcept {
+        static CommitRing ring;
+        return ring;
+    }
+
+    uint64_t index() const noexcept {
+        return index_.load(std::memory_order_acquire);
+    }
+
+    bool tryClaim(uint64_t expected) noexcept {
+        return index_.compare_exchange_strong(expected, expected + 1, std::memory_order_acq_rel);
+    }
+
+    // 写回是否已经完成
+    bool isComplete(uint64_t ts) const noexcept {
+        return entryOf_(ts).done.load(std::memory_order_acquire) == ts;
+    }
+
+    void waitComplete(uint64_t ts) const noexcept {
+        while (!isComplete(ts)) spin_();
+    }
+
+    // 在 tryClaim 成功之后调用：等待旧槽位退役，再发布写签名
+    void publish(uint64_t ts, const Sig& wsig) noexcept {
+        Entry& e = entryOf_(ts);
+        if (ts >= kRingSize) {
+            waitComplete(ts - kRingSize);
+        }
+
+        // 类 seqlock：先标记改写中，再写签名，最后发布时间戳
+        e.ts.store(kWriting, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        e.filter.publish(wsig);
+        e.ts.store(ts, std::memory_order_release);
+    }
+
+    void markComplete(uint64_t ts) noexcept {
+        entryOf_(ts).done.store(ts, std::memory_order_release);
+    }
+
+    // 检查第 ts 个槽位的写签名是否与读签名相交。
+    // 返回 false 表示槽位已被覆盖，无法判断 (调用方应回滚)
+    bool checkEntry(uint64_t ts, const Sig& rsig, bool& conflict) const noexcept {
+        const Entry& e = entryOf_(ts);
+
+        uint64_t seen;
+        while ((seen = e.ts.load(std::memory_order_acquire)) != ts) {
+            // 槽位已被更新的提交覆盖
+            if (seen != kWriting && seen > ts) return false;
+            spin_();
+        }
+
+        conflict = e.filter.intersects(rsig);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return e.ts.load(std::memory_order_relaxed) == ts;
+    }
+
+    CommitRing(const CommitRing&) = delete;
+    CommitRing& operator=(const CommitRing&) = delete;
+
+private:
+    struct alignas(kCacheLineSize) Entry {
+        std::atomic<uint64_t> ts{0};
+        std::atomic<uint64_t> done{0};
+        SharedSignature<kSignatureBits> filter;
+    };
+
+    CommitRing() = default;
+
+    Entry& entryOf_(uint64_t ts) noexcept { return ring_[ts % kRingSize]; }
+    const Entry& entryOf_(uint64_t ts) const noexcept { return ring_[ts % kRingSize]; }
+
+    static void spin_() noexcept {
+        _mm_pause();
+        std::this_thread::yield();
+    }
+
+private:
+    alignas(kCacheLineSize) std::atomic<uint64_t> index_{0};
+    Entry ring_[kRingSize];
+};
+
+} // namespace Ring
+} // namespace STM
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "Transaction.hpp"
+#include "EBRManager/EBRManager.hpp"
+#include <thread>
+#include <type_traits>
+
+namespace STM {
+namespace Ring {
+
+    inline TxDescriptor& getLocalDescriptor () {
+        static thread_local TxDescriptor desc;
+        return desc;
+    }
+
+    inline Transaction& getLocalTransaction () {
+        static thread_local Transaction tx(&getLocalDescriptor());
+        return tx;
+    }
+
+    // 与 STM::atomically 相同的用法，变量类型 Ring::TMVar<T> 即 STM::Var<T>
+    template<typename F>
+    auto atomically(F&& func) {
+        EBRManager::instance()->enter();
+
+        Transaction& tx = getLocalTransaction();
+
+        while (true) {
+            try {
+                tx.begin();
+
+                if constexpr (std::is_void_v<std::invoke_result_t<F, Transaction&>>) {
+                    func(tx);
+
+                    if(tx.commit()) {
+                        break;
+                    }
+                }
+                else {
+                    auto result = func(tx);
+                    if(tx.commit()) {
+                        EBRManager::instance()->leave();
+                        return result;
+                    }
+                }
+            }
+            catch(const RetryException&){
+                tx.abort();
+                std::this_thread::yield();
+                continue;
+            }
+            catch(...) {
+                tx.abort();
+                EBRManager::instance()->leave();
+                throw;
+            }
+        }
+
+        EBRManager::instance()->leave();
+    }
+
+} // namespace Ring
+} // namespace STM
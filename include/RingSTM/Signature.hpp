@@ -0,0 +1,78 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace STM {
+namespace Ring {
+
+// 地址 -> 两个比特位置 (Bloom Filter, k = 2)
+template<size_t Bits>
+struct SignatureHash {
+    static_assert((Bits & (Bits - 1)) == 0, "Signature size must be a power of two");
+    static constexpr size_t kMask = Bits - 1;
+
+    static void positions(const void* addr, size_t& b1, size_t& b2) noexcept {
+        uint64_t h = (reinterpret_cast<uintptr_t>(addr) >> 3) * 0x9E3779B97F4A7C15ull;
+        b1 = static_cast<size_t>(h >> 40) & kMask;
+        b2 = static_cast<size_t>(h >> 12) & kMask;
+    }
+};
+
+
+// 事务私有的签名 (读签名 / 写签名)，只由所属线程访问
+template<size_t Bits>
+class Signature {
+public:
+    static constexpr size_t kWords = Bits / 64;
+
+    void add(const void* addr) noexcept {
+        size_t b1, b2;
+        SignatureHash<Bits>::positions(addr, b1, b2);
+        words_[b1 >> 6] |= (1ull << (b1 & 63));
+        words_[b2 >> 6] |= (1ull << (b2 & 63));
+        empty_ = false;
+    }
+
+    void clear() noexcept {
+        if (empty_) return;
+        for (size_t i = 0; i < kWords; ++i) words_[i] = 0;
+        empty_ = true;
+    }
+
+    bool empty() const noexcept { return empty_; }
+    uint64_t word(size_t i) const noexcept { return words_[i]; }
+
+private:
+    uint64_t words_[kWords] = {};
+    bool empty_ = true;
+};
+
+
+// 发布到提交环上的签名：其他线程并发读取，因此按字原子化
+template<size_t Bits>
+class SharedSignature {
+public:
+    static constexpr size_t kWords = Bits / 64;
+
+    void publish(const Signature<Bits>& sig) noexcept {
+        for (size_t i = 0; i < kWords; ++i) {
+            words_[i].store(sig.word(i), std::memory_order_relaxed);
+        }
+    }
+
+    // 与读签名是否有交集 (可能误报，不会漏报)
+    bool intersects(const Signature<Bits>& sig) const noexcept {
+        for (size_t i = 0; i < kWords; ++i) {
+            if (words_[i].load(std::memory_order_relaxed) & sig.word(i)) return true;
+        }
+        return false;
+    }
+
+private:
+    std::atomic<uint64_t> words_[kWords] = {};
+};
+
+} // namespace Ring
+} // namespace STM
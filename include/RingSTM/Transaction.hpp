@@ -0,0 +1,157 @@
+#pragma once
+
+#include <cstdint>
+#include <exception>
+#include <vector>
+
+#include "CommitRing.hpp"
+#include "OccSTM/TMVar.hpp"
+#include "OccSTM/TransactionDescriptor.hpp"
+#include "TierAlloc/ThreadHeap/ThreadHeap.hpp"
+
+namespace STM {
+namespace Ring {
+
+struct RetryException : public std::exception {};
+
+// RingSTM 直接复用 Occ 的 TMVar 作为数据载体：
+// 读取 head 上的最新节点，写回时通过 TMVar::committer 挂上新版本。
+// 同一个 TMVar 不应同时被 Occ 与 Ring 两个引擎并发写入。
+template<typename T>
+using TMVar = Occ::TMVar<T>;
+
+// 事务状态：写集沿用 Occ 的类型擦除日志，读集只剩一个签名
+class TxDescriptor {
+public:
+    using Sig = CommitRing::Sig;
+
+    TxDescriptor() {
+        write_set_.reserve(16);
+    }
+
+    ~TxDescriptor() {
+        reset();
+    }
+
+    void reset() {
+        for (void* ptr : allocated_ptrs_) {
+            ThreadHeap::deallocate(ptr);
+        }
+        allocated_ptrs_.clear();
+
+        for (Occ::WriteLogEntry& entry : write_set_) {
+            if (entry.deleter && entry.new_node) {
+                entry.deleter(entry.new_node);
+            }
+        }
+        write_set_.clear();
+
+        read_sig_.clear();
+        write_sig_.clear();
+        start_ = 0;
+    }
+
+    uint64_t start() const { return start_; }
+    void setStart(uint64_t s) { start_ = s; }
+
+    Sig& readSignature() { return read_sig_; }
+    Sig& writeSignature() { return write_sig_; }
+
+    std::vector<Occ::WriteLogEntry>& writeSet() { return write_set_; }
+
+    void recordAllocation(void* ptr) { allocated_ptrs_.push_back(ptr); }
+    void commitAllocations() { allocated_ptrs_.clear(); }
+
+private:
+    uint64_t start_{0};
+    Sig read_sig_;
+    Sig write_sig_;
+    std::vector<Occ::WriteLogEntry> write_set_;
+    std::vector<void*> allocated_ptrs_;
+};
+
+
+class Transaction {
+public:
+    explicit Transaction(TxDescriptor* desc) : desc_(desc) {}
+
+    void begin();
+    bool commit();
+    void abort() { desc_->reset(); }
+
+    template<typename T>
+    T load(TMVar<T>& var);
+
+    template<typename T>
+    void store(TMVar<T>& var, const T& val);
+
+    template<typename T, typename... Args>
+    T* alloc(Args&&... args);
+
+    template<typename T>
+    void free(T* ptr);
+
+private:
+    // 用提交环上 (start, 最新] 的写签名验证读签名，upto 返回验证到的位置
+    bool validate_(uint64_t& upto);
+
+private:
+    TxDescriptor* desc_;
+};
+
+
+template<typename T>
+T Transaction::load(TMVar<T>& var) {
+    using Node = typename TMVar<T>::Node;
+
+    // 1. Read-Your-Own-Writes
+    auto& wset = desc_->writeSet();
+    for (auto it = wset.rbegin(); it != wset.rend(); ++it) {
+        if (it->tmvar_addr == &var) return static_cast<Node*>(it->new_node)->payload;
+    }
+
+    // 2. 先把快照推进到最新提交 (用已有读签名验证)，避免刚读的变量被误判冲突
+    uint64_t upto;
+    if (!validate_(upto)) {
+        throw RetryException();
+    }
+
+    // 3. 读最新版本，登记读签名，再用提交环做后置验证
+    Node* curr = var.loadHead();
+    T val = curr->payload;
+    desc_->readSignature().add(&var);
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (!validate_(upto)) {
+        throw RetryException();
+    }
+
+    return val;
+}
+
+template<typename T>
+void Transaction::store(TMVar<T>& var, const T& val) {
+    using Node = typename TMVar<T>::Node;
+    Node* node = new Node(0, nullptr, val);
+
+    desc_->writeSignature().add(&var);
+    desc_->writeSet().push_back({&var, node, TMVar<T>::committer, TMVar<T>::deleter});
+}
+
+template<typename T, typename... Args>
+T* Transaction::alloc(Args&&... args) {
+    void* raw_mem = ThreadHeap::allocate(sizeof(T));
+    desc_->recordAllocation(raw_mem);
+    return new(raw_mem) T(std::forward<Args>(args)...);
+}
+
+template<typename T>
+void Transaction::free(T* ptr) {
+    if (!ptr) return;
+
+    ptr->~T();
+    ThreadHeap::deallocate(ptr);
+}
+
+} // namespace Ring
+} // namespace STM
@@ -8,7 +8,8 @@ struct alignas(kCacheLineSize) ChunkHeader {
 public:
     enum class Type : uint8_t {
         SMALL = 0,
-        LARGE = 1
+        LARGE = 1,
+        BULK  = 2   // 批量构造区 (如 TMVarArena)：块内对象不单独释放，随整块归还
     };
 
     Type    type = Type::SMALL;
@@ -4,6 +4,7 @@
 #include "ThreadHeap/SlabList.hpp"
 
 #include <cassert>
+#include <cstddef>
 #include <cstdint>
 
 
@@ -17,6 +18,9 @@ public:
 
     [[nodiscard]] uint32_t getBlockSize() const { return block_size_; }
 
+    // 等待收养的遗弃 Slab 数 (所有尺寸)
+    [[nodiscard]] static size_t abandonedSlabCount();
+
 public:
     SizeClassPool() = default; 
 
@@ -34,6 +38,8 @@ private:
     void* allocFromPartial_();
     void* allocFromNew_();
     [[nodiscard]] void* allocFromRescue_();
+    [[nodiscard]] void* allocFromOrphan_();
+    void releaseOrAbandon_(Slab* slab);
 
 private:
     uint32_t block_size_ = 0;
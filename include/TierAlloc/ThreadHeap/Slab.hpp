@@ -3,6 +3,7 @@
 #include "common/AtomicFreeList.hpp"
 #include "ThreadHeap/ChunkHeader.hpp"
 
+#include <atomic>
 #include <cassert>
 #include <cstdint>
 
@@ -24,6 +25,8 @@ public:
     void freeRemote(void* ptr);
     uint32_t reclaimRemoteMemory();
     void Destroy();
+    void abandon();
+    void adopt(SizeClassPool* pool);
     
     [[nodiscard]] uint32_t block_size() const;
     [[nodiscard]] uint32_t max_block_count() const;
@@ -43,7 +46,8 @@ private:
 
     void* local_free_list_ = nullptr;
 
-    SizeClassPool* owner_ = nullptr;
+    // 遗弃/收养时由持有者以外的线程改写，其他线程释放时并发读取
+    std::atomic<SizeClassPool*> owner_{nullptr};
     
     char* bump_ptr_ = nullptr;
     char* end_ptr_ = nullptr;
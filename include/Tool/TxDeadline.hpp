@@ -0,0 +1,83 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace STM {
+
+// 带期限的事务 (STM::tryAtomically、Ww::TxContext::atomically) 的结果
+enum class TxOutcome {
+    Committed,
+    TimedOut,   // 期限已到，最后一次尝试已中止
+    Cancelled   // 取消令牌被触发，最后一次尝试已中止
+};
+
+// 取消令牌：拷贝共享同一个标志，任意线程调用 cancel 后，持有它的事务在下一次重试前放弃
+class CancellationToken {
+public:
+    CancellationToken() : flag_(std::make_shared<std::atomic<bool>>(false)) {}
+
+    void cancel() noexcept { flag_->store(true, std::memory_order_release); }
+    bool cancelled() const noexcept { return flag_->load(std::memory_order_acquire); }
+
+private:
+    friend class TxDeadline;
+    std::shared_ptr<std::atomic<bool>> flag_;
+};
+
+// 重试期限：截止时间和 (可选的) 取消令牌。默认构造的期限永不过期，检查时不读时钟。
+//
+//   auto limits = STM::TxDeadline::after(std::chrono::milliseconds(5)).cancelledBy(token);
+class TxDeadline {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    TxDeadline() = default;
+
+    static TxDeadline at(Clock::time_point when) {
+        TxDeadline limits;
+        limits.at_ = when;
+        return limits;
+    }
+
+    static TxDeadline after(Clock::duration timeout) { return at(Clock::now() + timeout); }
+
+    TxDeadline& cancelledBy(const CancellationToken& token) {
+        cancelled_ = token.flag_;
+        return *this;
+    }
+
+    // 已取消或已到期时返回原因，否则返回 std::nullopt。取消优先于超时
+    std::optional<TxOutcome> expired() const {
+        if (cancelled_ && cancelled_->load(std::memory_order_acquire)) return TxOutcome::Cancelled;
+        if (at_ != Clock::time_point::max() && Clock::now() >= at_) return TxOutcome::TimedOut;
+        return std::nullopt;
+    }
+
+private:
+    Clock::time_point at_ = Clock::time_point::max();
+    std::shared_ptr<const std::atomic<bool>> cancelled_;
+};
+
+// tryAtomically 的返回值：只有 Committed 时 value 有值
+template<typename R>
+struct TxResult {
+    TxOutcome outcome;
+    std::optional<R> value;
+
+    bool committed() const noexcept { return outcome == TxOutcome::Committed; }
+    explicit operator bool() const noexcept { return committed(); }
+};
+
+template<>
+struct TxResult<void> {
+    TxOutcome outcome;
+
+    bool committed() const noexcept { return outcome == TxOutcome::Committed; }
+    explicit operator bool() const noexcept { return committed(); }
+};
+
+} // namespace STM
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "TierAlloc/ThreadHeap/ThreadHeap.hpp"
+#include "TierAlloc/common/GlobalConfig.hpp"
+
+namespace STM {
+
+// 事务变量的内存布局策略
+//   PackedLayout:    变量紧密排列 (Occ::TMVar 只有 8 字节，一条缓存行放 8 个)，适合读多写少的变量
+//   CacheLineLayout: 变量独占一条缓存行，提交时不会让相邻变量的读者缓存失效，适合写热点
+struct PackedLayout {
+    static constexpr bool kPadded = false;
+};
+
+struct CacheLineLayout {
+    static constexpr bool kPadded = true;
+};
+
+// 独占缓存行的变量：派生自 V，可以直接传给所有接受 V& 的事务接口
+template<typename V>
+struct alignas(kCacheLineSize) CacheLinePadded : V {
+    using V::V;
+};
+
+template<typename V, typename Layout>
+using LaidOut = std::conditional_t<Layout::kPadded, CacheLinePadded<V>, V>;
+
+// 与 makeOnThreadHeap 配对的删除器
+struct ThreadHeapDelete {
+    template<typename V>
+    void operator()(V* p) const noexcept {
+        p->~V();
+        ThreadHeap::deallocate(p);
+    }
+};
+
+template<typename V>
+using ThreadHeapPtr = std::unique_ptr<V, ThreadHeapDelete>;
+
+// 在当前线程的 ThreadHeap 上构造对象。大小为缓存行整数倍的尺寸类在 Slab 中按缓存行对齐排列，
+// 因此 CacheLinePadded 对象恰好各占一条缓存行；紧密布局的变量则与同线程分配的同尺寸变量相邻。
+template<typename V, typename... Args>
+ThreadHeapPtr<V> makeOnThreadHeap(Args&&... args) {
+    static_assert(alignof(V) <= kCacheLineSize, "ThreadHeap cannot satisfy this alignment");
+
+    void* mem = ThreadHeap::allocate(sizeof(V));
+    if (!mem) throw std::bad_alloc();
+    assert(reinterpret_cast<uintptr_t>(mem) % alignof(V) == 0);
+
+    try {
+        return ThreadHeapPtr<V>(new (mem) V(std::forward<Args>(args)...));
+    }
+    catch (...) {
+        ThreadHeap::deallocate(mem);
+        throw;
+    }
+}
+
+} // namespace STM
@@ -4,15 +4,17 @@
 #include <cstdint>
 #include <type_traits>
 #include <thread>
-#include <functional> 
-#include <cstdio> // 必须包含用于 printf
+#include <cstdio>
+#include <cstdlib>
 
 #include "TaggedPtr.hpp"
+#include "Trace.hpp"
 #include "VersionNode.hpp"
 #include "WriteRecord.hpp"
 #include "EBRManager/EBRManager.hpp"
 #include "WwSTM/TxDescriptor.hpp"
 #include "WwSTM/TxStatus.hpp"
+#include "Tool/VarLayout.hpp"
 
 namespace STM {
 namespace Ww {
@@ -27,6 +29,8 @@ struct TMVarBase {
 };
 
 
+// 单字头指针 (见 OSTM_WW.md 2.3)：head_ 要么指向稳态的 VersionNode，要么指向带标记位的 WriteRecord。
+// 读取只需一次 acquire 读，加锁 / 回滚 / 提交各是一次 CAS 或 store，读者不会看到两个字段的中间组合。
 template <typename T>
 class TMVar : public TMVarBase {
 public:
@@ -34,27 +38,20 @@ public:
     using RecordT = detail::WriteRecord<T>;
 
 private:
-    std::atomic<NodeT*> data_ptr_;
-    std::atomic<RecordT*> record_ptr_;
-
-    // 日志辅助：获取短线程ID
-    size_t get_tid() const {
-        return std::hash<std::thread::id>{}(std::this_thread::get_id()) % 1000;
-    }
+    std::atomic<uintptr_t> head_;
 
 public:
     template<typename... Args>
-    TMVar(Args&&...args) : record_ptr_(nullptr) {
+    TMVar(Args&&...args) {
         NodeT* init_node = new NodeT(0, std::forward<Args>(args)...);
-        data_ptr_.store(init_node, std::memory_order_release);
-        std::printf("[T%zu] [CONSTRUCT] Var:%p | InitDataNode:%p | Initialized\n", get_tid(), (void*)this, (void*)init_node);
+        head_.store(TaggedPtrHelper::packNode(init_node), std::memory_order_release);
+        trace::emit<trace::kDebug>(trace::Event::VarConstruct, this, init_node);
     }
 
     ~TMVar() {
-        std::printf("[T%zu] [DESTRUCT] Var:%p | Destroying TMVar\n", get_tid(), (void*)this);
-        // EBRManager::instance()->retire(data_ptr_.load(std::memory_order_acquire));
-        // RecordT* rec = record_ptr_.load(std::memory_order_acquire);
-        // if (rec) EBRManager::instance()->retire(rec);
+        trace::emit<trace::kDebug>(trace::Event::VarDestruct, this);
+        // uintptr_t raw = head_.load(std::memory_order_acquire);
+        // if (TaggedPtrHelper::isNode(raw)) EBRManager::instance()->retire(TaggedPtrHelper::unpackNode<NodeT>(raw));
     }
 
     // 禁止拷贝和移动
@@ -64,57 +61,67 @@ public:
     TMVar& operator=(TMVar&&) = delete;
 
     T readProxy(TxDescriptor* tx) {
-        size_t tid = get_tid();
-        RecordT* record = record_ptr_.load(std::memory_order_acquire);
+        return *viewProxy(tx);
+    }
+
+    // 与 readProxy 相同的可见性规则，但返回节点内 payload 的地址 (不拷贝)
+    const T* viewProxy(TxDescriptor* tx) {
+        uintptr_t raw = head_.load(std::memory_order_acquire);
 
         // Case 1: 无锁 -> 直接读
-        if(record == nullptr) {
-            NodeT* node = data_ptr_.load(std::memory_order_acquire);
-            std::printf("[T%zu] [READ-STABLE] Var:%p | Node:%p | ValAddr:%p\n", tid, (void*)this, (void*)node, (void*)&node->payload);
-            
-            if (((uintptr_t)node & 0x3)) {
-                std::printf("[T%zu] [CRITICAL] Var:%p | Corrupt stable node pointer detected: %p\n", tid, (void*)this, (void*)node);
-            }
-            return node->payload;
+        if (TaggedPtrHelper::isNode(raw)) {
+            NodeT* node = TaggedPtrHelper::unpackNode<NodeT>(raw);
+            trace::emit<trace::kDebug>(trace::Event::ReadStable, this, node);
+            return &node->payload;
         }
 
+        RecordT* record = TaggedPtrHelper::unpackRecord<RecordT>(raw);
+
         // Case 2: 有锁 -> 检查 Owner
         if(record->owner == tx) {
-            std::printf("[T%zu] [READ-OWNER] Var:%p | TxDesc:%p | Reading my own NewNode:%p\n", tid, (void*)this, (void*)tx, (void*)record->new_node);
-            return record->new_node->payload;
+            trace::emit<trace::kDebug>(trace::Event::ReadOwner, this, record->new_node);
+            return &record->new_node->payload;
         }
 
         // Case 3: 冲突检测 (Wound-Wait 读策略)
         TxStatus status = record->owner->status.load(std::memory_order_acquire);
 
         if (status == TxStatus::COMMITTED) {
-            std::printf("[T%zu] [READ-SNAPSHOT] Var:%p | Owner:%p (COMMITTED) | Reading NewNode:%p\n", tid, (void*)this, (void*)record->owner, (void*)record->new_node);
-            return record->new_node->payload;
+            trace::emit<trace::kDebug>(trace::Event::ReadCommitted, this, record->new_node);
+            return &record->new_node->payload;
         } 
         else {
-            std::printf("[T%zu] [READ-SNAPSHOT] Var:%p | Owner:%p (ACTIVE/ABORT) | Reading OldNode:%p\n", tid, (void*)this, (void*)record->owner, (void*)record->old_node);
-            return record->old_node->payload;
+            trace::emit<trace::kDebug>(trace::Event::ReadSnapshot, this, record->old_node);
+            return &record->old_node->payload;
         }
     }
 
     void* tryWriteAndGetRecord(TxDescriptor* tx, const void* val_ptr, TxDescriptor*& out_conflict) {
-        auto tid = get_tid();
-        
         NodeT* my_new_node = new NodeT(tx->start_ts, *static_cast<const T*>(val_ptr));
+        void* record = tryInstallNode(tx, my_new_node, out_conflict);
+        if (!record) delete my_new_node;
+        return record;
+    }
+
+    // 与 tryWriteAndGetRecord 相同，但使用调用者已构造好的新节点；
+    // 冲突时节点仍归调用者所有，可以留到下一次重试，不必重新构造值
+    void* tryInstallNode(TxDescriptor* tx, NodeT* my_new_node, TxDescriptor*& out_conflict) {
         RecordT* my_record = new RecordT(tx, nullptr, my_new_node);
 
-        std::printf("[T%zu] [WRITE-INIT] Var:%p | NewNode:%p | Record:%p | StartTS:%lu\n", tid, (void*)this, (void*)my_new_node, (void*)my_record, tx->start_ts);
+        trace::emit<trace::kDebug>(trace::Event::WriteInit, this, tx->start_ts);
 
         while (true) {
-            RecordT* current = record_ptr_.load(std::memory_order_acquire);
-            NodeT* stable_node = data_ptr_.load(std::memory_order_acquire);
-            
-            my_record->old_node = stable_node;
+            uintptr_t raw = head_.load(std::memory_order_acquire);
+
+            if (TaggedPtrHelper::isNode(raw)) {
+                my_record->old_node = TaggedPtrHelper::unpackNode<NodeT>(raw);
+            }
+            else {
+                RecordT* current = TaggedPtrHelper::unpackRecord<RecordT>(raw);
 
-            if(current != nullptr) {
                 // --- 重入 (Re-entrant) ---
                 if (current->owner == tx) {
-                    std::printf("[T%zu] [WRITE-REENTRANT] Var:%p | Owner:%p | Replacing DraftNode %p -> %p\n", tid, (void*)this, (void*)tx, (void*)current->new_node, (void*)my_new_node);
+                    trace::emit<trace::kDebug>(trace::Event::WriteReentrant, this, my_new_node);
                     
                     my_record->old_node = nullptr; 
                     my_record->new_node = nullptr; 
@@ -123,6 +130,7 @@ public:
                     NodeT* old_draft_node = current->new_node;
                     current->new_node = my_new_node; 
                     // EBRManager::instance()->retire(old_draft_node); 
+                    (void)old_draft_node;
                     return current;
                 }
 
@@ -130,30 +138,31 @@ public:
 
                 // --- 冲突 (Active) ---
                 if(status == TxStatus::ACTIVE) {
-                    std::printf("[T%zu] [WRITE-CONFLICT] Var:%p | Owner:%p is ACTIVE | Failing\n", tid, (void*)this, (void*)current->owner);
+                    trace::emit<trace::kInfo>(trace::Event::WriteConflict, this, current->owner);
                     out_conflict = current->owner;
-                    delete my_new_node;
+                    my_record->new_node = nullptr;
                     delete my_record;
                     return nullptr;
                 }
                 
                 // --- 冲突 (Committed but not cleaned) ---
                 if (status == TxStatus::COMMITTED) {
-                    std::printf("[T%zu] [WRITE-WAIT] Var:%p | Owner:%p is COMMITTED | Yielding\n", tid, (void*)this, (void*)current->owner);
+                    trace::emit<trace::kInfo>(trace::Event::WriteWait, this, current->owner);
                     std::this_thread::yield();
                     continue; 
                 }
 
-                // --- 抢占 (Steal Aborted) ---
-                std::printf("[T%zu] [WRITE-STEAL] Var:%p | Owner:%p is ABORTED | Stealing lock\n", tid, (void*)this, (void*)current->owner);
+                // --- 抢占 (Steal Aborted)：逻辑上的当前值是被中止者的旧版本 ---
+                trace::emit<trace::kInfo>(trace::Event::WriteSteal, this, current->owner);
+                my_record->old_node = current->old_node;
             }
 
             // --- CAS 尝试上位 ---
-            RecordT* expected = current;
-            if (record_ptr_.compare_exchange_strong(expected, my_record, std::memory_order_acq_rel)) {
-                std::printf("[T%zu] [WRITE-LOCKED] Var:%p | Record %p successfully acquired lock\n", tid, (void*)this, (void*)my_record);
+            uintptr_t expected = raw;
+            if (head_.compare_exchange_strong(expected, TaggedPtrHelper::packRecord(my_record), std::memory_order_acq_rel)) {
+                trace::emit<trace::kDebug>(trace::Event::WriteLocked, this, my_record);
 
-                if (current != nullptr) {
+                if (TaggedPtrHelper::isRecord(raw)) {
                     // EBRManager::instance()->retire(current->new_node);
                     // EBRManager::instance()->retire(current);
                 }
@@ -161,75 +170,88 @@ public:
                 return my_record;
             } 
             else {
-                std::printf("[T%zu] [WRITE-RETRY] Var:%p | CAS failed, someone else updated record_ptr_\n", tid, (void*)this);
+                trace::emit<trace::kDebug>(trace::Event::WriteRetry, this);
             }
         }
     }
 
     void commitReleaseRecord(const uint64_t commit_ts) override {
-        auto tid = get_tid();
-        RecordT* record = record_ptr_.load(std::memory_order_acquire);
+        uintptr_t raw = head_.load(std::memory_order_acquire);
         
-        if (!record) {
-            std::printf("[T%zu] [COMMIT-ERROR] Var:%p | record_ptr_ is NULL during commit!\n", tid, (void*)this);
+        if (!TaggedPtrHelper::isRecord(raw)) {
+            trace::emit<trace::kError>(trace::Event::CommitNoRecord, this);
             return; 
         }
 
-        std::printf("[T%zu] [COMMIT-START] Var:%p | Promoting NewNode:%p to Stable | CommitTS:%lu\n", tid, (void*)this, (void*)record->new_node, commit_ts);
+        // 事务已是 COMMITTED，记录不会再被抢占
+        RecordT* record = TaggedPtrHelper::unpackRecord<RecordT>(raw);
 
-        // 验证指针合法性
-        if (((uintptr_t)record->new_node & 0x3)) {
-            std::printf("[T%zu] [CRITICAL-COMMIT] Var:%p | Promoting corrupt NewNode pointer: %p\n", tid, (void*)this, (void*)record->new_node);
-        }
+        trace::emit<trace::kInfo>(trace::Event::CommitStart, this, commit_ts);
 
         record->new_node->write_ts = commit_ts;
-        data_ptr_.store(record->new_node, std::memory_order_release);
-        record_ptr_.store(nullptr, std::memory_order_release);
+        head_.store(TaggedPtrHelper::packNode(record->new_node), std::memory_order_release);
 
-        std::printf("[T%zu] [COMMIT-SUCCESS] Var:%p | Lock released, data_ptr_ updated\n", tid, (void*)this);
+        trace::emit<trace::kInfo>(trace::Event::CommitDone, this);
 
         // EBRManager::instance()->retire(record->old_node);
         // EBRManager::instance()->retire(record);
     }
 
     void abortRestoreData(void* saved_record_ptr) override {
-        auto tid = get_tid();
         auto* my_record = static_cast<RecordT*>(saved_record_ptr);
         
-        std::printf("[T%zu] [ABORT-START] Var:%p | Attempting to rollback Record:%p\n", tid, (void*)this, (void*)my_record);
+        trace::emit<trace::kInfo>(trace::Event::AbortStart, this, my_record);
 
-        RecordT* expected = my_record;
-        if (record_ptr_.compare_exchange_strong(expected, nullptr, std::memory_order_acq_rel)) {
-            std::printf("[T%zu] [ABORT-CLEAN] Var:%p | Rollback success, lock cleared\n", tid, (void*)this);
+        uintptr_t expected = TaggedPtrHelper::packRecord(my_record);
+        if (head_.compare_exchange_strong(expected, TaggedPtrHelper::packNode(my_record->old_node), std::memory_order_acq_rel)) {
+            trace::emit<trace::kInfo>(trace::Event::AbortRestored, this);
             // EBRManager::instance()->retire(my_record->new_node);
             // EBRManager::instance()->retire(my_record);
         } 
         else {
-            std::printf("[T%zu] [ABORT-STOLEN] Var:%p | Lock was already stolen by Record:%p\n", tid, (void*)this, (void*)expected);
+            trace::emit<trace::kInfo>(trace::Event::AbortStolen, this);
         }
     }
 
+    // 当前已提交版本的时间戳。遇到已提交但尚未收尾的记录时等它换回节点，
+    // 保证与随后读到的值 (新版本) 一致
     uint64_t getDataVersion() const override {
         if (reinterpret_cast<uintptr_t>(this) < 4096) {
-            std::printf("[FATAL] TMVar 'this' is invalid! Addr: %p\n", (void*)this);
+            trace::emit<trace::kFatal>(trace::Event::FatalBadVar, this);
+            std::fprintf(stderr, "[FATAL] Ww::TMVar: invalid this pointer %p\n", static_cast<const void*>(this));
             std::abort();
         }
 
-        NodeT* node = data_ptr_.load(std::memory_order_acquire);
-        
-        if (node == nullptr) {
-            std::printf("[FATAL] Var:%p | data_ptr_ is NULL!\n", (void*)this);
-            std::abort();
-        }
+        while (true) {
+            uintptr_t raw = head_.load(std::memory_order_acquire);
 
-        if (((uintptr_t)node & 0x3)) {
-            std::printf("[FATAL] Var:%p | Corrupt node pointer in getDataVersion: %p\n", (void*)this, (void*)node);
-            // 这里不立刻 abort，让日志输完
-        }
+            if (raw == 0) {
+                trace::emit<trace::kFatal>(trace::Event::FatalNullHead, this);
+                std::fprintf(stderr, "[FATAL] Ww::TMVar %p: head_ is NULL\n", static_cast<const void*>(this));
+                std::abort();
+            }
 
-        return node->write_ts; 
+            if (TaggedPtrHelper::isNode(raw)) {
+                return TaggedPtrHelper::unpackNode<NodeT>(raw)->write_ts;
+            }
+
+            RecordT* record = TaggedPtrHelper::unpackRecord<RecordT>(raw);
+            if (record->owner->status.load(std::memory_order_acquire) != TxStatus::COMMITTED) {
+                return record->old_node->write_ts;
+            }
+            std::this_thread::yield();
+        }
     }
 };
 
+// Ww::TMVar 本身带虚表与一个原子字 (16 字节)；写热点变量可以选择独占缓存行
+template<typename T, typename Layout>
+using LaidOutVar = LaidOut<TMVar<T>, Layout>;
+
+template<typename T, typename Layout = CacheLineLayout, typename... Args>
+ThreadHeapPtr<LaidOutVar<T, Layout>> makeVar(Args&&... args) {
+    return makeOnThreadHeap<LaidOutVar<T, Layout>>(std::forward<Args>(args)...);
+}
+
 } // namespace Ww
 } // namespace STM
\ No newline at end of file
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iosfwd>
+#include <type_traits>
+#include <vector>
+
+// WwSTM 事务跟踪的编译期级别：
+//   0 关闭 (默认，所有跟踪点编译为空)
+//   1 错误/致命  (提交时找不到自己的写记录等不应出现的状态；致命事件记录后向 stderr 打印一行并 abort，环来不及导出)
+//   2 冲突/结果  (写冲突、持锁后发现读过的版本已变、抢占、提交、回滚)
+//   3 全部       (每次读取、加锁尝试、变量构造析构)
+// 由 CMake 的 STM_WW_TRACE_LEVEL 缓存变量设置。
+#ifndef STM_WW_TRACE_LEVEL
+#define STM_WW_TRACE_LEVEL 0
+#endif
+
+namespace STM {
+namespace Ww {
+namespace trace {
+
+inline constexpr int kLevel = STM_WW_TRACE_LEVEL;
+
+inline constexpr int kFatal = 1;
+inline constexpr int kError = 1;
+inline constexpr int kInfo = 2;
+inline constexpr int kDebug = 3;
+
+enum class Event : uint16_t {
+    VarConstruct,       // a = var, b = 初始节点
+    VarDestruct,        // a = var
+    ReadStable,         // a = var, b = 节点
+    ReadOwner,          // a = var, b = 自己的新节点
+    ReadCommitted,      // a = var, b = 已提交者的新节点
+    ReadSnapshot,       // a = var, b = 活跃/已中止者的旧节点
+    WriteInit,          // a = var, b = 事务开始时间戳
+    WriteReentrant,     // a = var, b = 新草稿节点
+    WriteConflict,      // a = var, b = 活跃的持有者
+    WriteWait,          // a = var, b = 已提交未收尾的持有者
+    WriteSteal,         // a = var, b = 已中止的持有者
+    WriteLocked,        // a = var, b = 写记录
+    WriteRetry,         // a = var
+    WriteStale,         // a = var, b = 读取时的版本
+    CommitStart,        // a = var, b = 提交时间戳
+    CommitDone,         // a = var
+    CommitNoRecord,     // a = var
+    AbortStart,         // a = var, b = 写记录
+    AbortRestored,      // a = var
+    AbortStolen,        // a = var
+    FatalBadVar,        // a = var (this 指针无效)
+    FatalNullHead,      // a = var (head_ 为空)
+    kCount
+};
+
+const char* eventName(Event e) noexcept;
+
+// 定长二进制事件 (32 字节)
+struct Record {
+    uint64_t ts_ns;     // steady_clock 纳秒
+    uint16_t event;
+    uint16_t reserved;
+    uint32_t thread;    // 线程环的编号
+    uint64_t a;
+    uint64_t b;
+};
+static_assert(sizeof(Record) == 32, "trace records are fixed-size");
+
+// 每线程一个的环形缓冲：只有所属线程写入 (无锁、无 stdio)，写满后覆盖最旧的事件。
+// 线程退出后环仍留在全局登记表中，可以继续导出，直到被之后新建的线程复用。
+class Ring {
+public:
+    static constexpr size_t kCapacity = 4096;
+
+    explicit Ring(uint32_t id) : id_(id) {}
+
+    // 交给新线程复用：换成新编号，已记录的事件保留到被覆盖为止 (只能在没有线程写入时调用)
+    void rebind(uint32_t id) noexcept { id_ = id; }
+
+    void push(Event e, uint64_t a, uint64_t b) noexcept {
+        Record r;
+        r.ts_ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+        r.event = static_cast<uint16_t>(e);
+        r.reserved = 0;
+        r.thread = id_;
+        r.a = a;
+        r.b = b;
+
+        uint64_t words[kWords];
+        std::memcpy(words, &r, sizeof(r));
+
+        // 每个槽是一个小 seqlock：写入期间序号为奇数，写完为 2 * pos + 2
+        uint64_t pos = head_.load(std::memory_order_relaxed);
+        Slot& slot = slots_[pos & (kCapacity - 1)];
+        slot.seq.store(2 * pos + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < kWords; ++i) slot.words[i].store(words[i], std::memory_order_relaxed);
+        slot.seq.store(2 * pos + 2, std::memory_order_release);
+        head_.store(pos + 1, std::memory_order_release);
+    }
+
+    // 按时间顺序追加最近的事件 (最多 kCapacity 个)。所属线程仍在写入时，
+    // 拷贝期间被覆盖的最旧几条会被丢弃 (按槽的序号判断)，不会返回半新半旧的记录
+    void copyTo(std::vector<Record>& out) const;
+
+    // 丢弃已记录的事件 (只能在所属线程不写入时调用)
+    void reset() noexcept { head_.store(0, std::memory_order_release); }
+
+    uint64_t written() const noexcept { return head_.load(std::memory_order_acquire); }
+    uint32_t id() const noexcept { return id_; }
+
+private:
+    // 槽按 64 位原子字存放 (relaxed 读写在常见平台上就是普通访存)，导出线程可以与所属线程并发读
+    static constexpr size_t kWords = sizeof(Record) / sizeof(uint64_t);
+
+    struct Slot {
+        std::atomic<uint64_t> seq;
+        std::atomic<uint64_t> words[kWords];
+    };
+
+    uint32_t id_;
+    std::atomic<uint64_t> head_{0};
+    Slot slots_[kCapacity];
+};
+
+// 当前线程的环 (首次使用时从登记表取一个空闲环或新建，线程退出时归还)
+Ring& localRing();
+
+// 无条件记录一条事件
+inline void record(Event e, uint64_t a = 0, uint64_t b = 0) noexcept {
+    localRing().push(e, a, b);
+}
+
+template<typename V>
+inline uint64_t toWord_(V v) noexcept {
+    if constexpr (std::is_pointer_v<V>) return reinterpret_cast<uintptr_t>(v);
+    else return static_cast<uint64_t>(v);
+}
+
+// 跟踪点：Level 高于编译期级别时整个调用 (包括参数转换) 被消除
+template<int Level, typename A = uint64_t, typename B = uint64_t>
+inline void emit([[maybe_unused]] Event e, [[maybe_unused]] A a = 0, [[maybe_unused]] B b = 0) noexcept {
+    if constexpr (Level <= kLevel) {
+        record(e, toWord_(a), toWord_(b));
+    }
+}
+
+// 所有线程环中的事件，按时间排序
+std::vector<Record> collect();
+
+// 清空所有环 (只能在没有线程写入时调用)
+void clear();
+
+// 已分配的环数 (诊断用)：不超过曾经同时存活并记录过事件的线程数
+size_t ringCount();
+
+// 二进制导出：文件头 "WWTRACE1" + 记录数 (uint64) + 定长记录
+void writeBinary(std::ostream& out);
+void writeBinary(std::ostream& out, const std::vector<Record>& records);
+
+// 离线解码
+bool readBinary(std::istream& in, std::vector<Record>& records);
+void decodeToText(const std::vector<Record>& records, std::ostream& out);
+void decodeToChromeJson(const std::vector<Record>& records, std::ostream& out);
+
+} // namespace trace
+} // namespace Ww
+} // namespace STM
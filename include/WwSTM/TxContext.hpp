@@ -3,14 +3,17 @@
 #include <atomic>
 #include <vector>
 #include <thread>
-#include <cstdio>
 #include <algorithm>
+#include <utility>
+#include <functional>
 
 #include "GlobalClock.hpp"
 #include "TxDescriptor.hpp"
 #include "TxStatus.hpp"
 #include "TMVar.hpp"
+#include "Trace.hpp"
 #include "EBRManager/EBRManager.hpp"
+#include "Tool/TxDeadline.hpp"
 
 namespace STM {
 namespace Ww {
@@ -35,9 +38,11 @@ private:
     std::vector<ReadLogEntry> read_set_;
     std::vector<WriteLogEntry> write_set_;
 
-    size_t get_tid() const {
-        return std::hash<std::thread::id>{}(std::this_thread::get_id()) % 1000;
-    }
+    std::vector<std::function<void()>> on_commit_;
+    std::vector<std::function<void()>> on_abort_;
+
+    // atomically 运行期间的期限，写冲突等待时也要检查
+    const TxDeadline* deadline_ = nullptr;
 
 public:
     TxContext(const TxContext&) = delete;
@@ -81,6 +86,7 @@ public:
 
         if (write_set_.empty()) {
             cleanupResources();
+            runHandlers(true);
             return true;
         }
 
@@ -95,9 +101,44 @@ public:
         }
 
         cleanupResources();
+        runHandlers(true);
         return true;
     }
 
+    // 结束回调，只对当前这次事务有效：提交成功后执行 onCommit 的回调，中止 (冲突、被抢占、期限到期、析构) 时执行 onAbort 的回调
+    void onCommit(std::function<void()> fn) { on_commit_.push_back(std::move(fn)); }
+    void onAbort(std::function<void()> fn) { on_abort_.push_back(std::move(fn)); }
+
+    // 有界的重试循环：反复 begin -> body(*this) -> commit 直到提交成功，
+    // 或 limits 到期 / 被取消 (此时当前尝试被中止，返回 TimedOut / Cancelled)。
+    // 等待写锁时同样检查期限，不会无限期地让位给更老的事务。
+    template<typename F>
+    TxOutcome atomically(F&& body, const TxDeadline& limits = TxDeadline()) {
+        deadline_ = &limits;
+        try {
+            while (true) {
+                if (auto reason = limits.expired()) {
+                    abortTransaction();
+                    deadline_ = nullptr;
+                    return *reason;
+                }
+
+                begin();
+                body(*this);
+                if (commit()) break;
+                std::this_thread::yield();
+            }
+        }
+        catch (...) {
+            abortTransaction();
+            deadline_ = nullptr;
+            throw;
+        }
+
+        deadline_ = nullptr;
+        return TxOutcome::Committed;
+    }
+
     template<typename T>
     T read(TMVar<T>& var) {
         if (!ensureActive()) return T{};
@@ -122,21 +163,57 @@ public:
         return val;
     }
 
+    // 零拷贝读取：与 read 相同的可见性与版本检查，但返回版本节点内 payload 的地址。
+    // 地址在本事务提交/中止前有效 (版本节点在此之前不会被回收)；事务已失效时返回 nullptr。
     template<typename T>
-    void write(TMVar<T>& var, const T& val) {
-        size_t tid = get_tid();
-        if (!ensureActive()) {
-            // std::printf("[T%zu] [WRITE-SKIP] Tx inactive, skipping write\n", tid);
-            return;
+    const T* view(TMVar<T>& var) {
+        if (!ensureActive()) return nullptr;
+
+        TMVarBase* var_base = static_cast<TMVarBase*>(&var);
+        for (auto& entry : read_set_) {
+            if (entry.var == var_base) {
+                return var.viewProxy(my_desc_);
+            }
         }
 
+        uint64_t v_pre = var.getDataVersion();
+        const T* val = var.viewProxy(my_desc_);
+        uint64_t v_post = var.getDataVersion();
+
+        if (v_pre != v_post) {
+            abortTransaction();
+            return nullptr;
+        }
+
+        read_set_.push_back({var_base, v_pre});
+        return val;
+    }
+
+    template<typename T>
+    void write(TMVar<T>& var, const T& val) {
+        emplace(var, val);
+    }
+
+    // 右值版本：把 val 移入新版本节点
+    template<typename T>
+    void write(TMVar<T>& var, T&& val) {
+        emplace(var, std::move(val));
+    }
+
+    // 用 args 在新版本节点内直接构造值；节点只构造一次，冲突重试时复用
+    template<typename T, typename... Args>
+    void emplace(TMVar<T>& var, Args&&... args) {
+        if (!ensureActive()) return;
+
+        using NodeT = typename TMVar<T>::NodeT;
         TMVarBase* var_base = static_cast<TMVarBase*>(&var);
+        NodeT* node = new NodeT(my_desc_->start_ts, std::forward<Args>(args)...);
         
         // 1. 重入检查：如果已经持有锁，直接更新
         for (const auto& entry : write_set_) {
             if (entry.var == var_base) {
                 TxDescriptor* dummy = nullptr;
-                var.tryWriteAndGetRecord(my_desc_, &val, dummy);
+                if (!var.tryInstallNode(my_desc_, node, dummy)) delete node;
                 return;
             }
         }
@@ -144,7 +221,7 @@ public:
         // 2. 尝试获取锁
         while (true) {
             TxDescriptor* conflict_tx = nullptr;
-            void* record = var.tryWriteAndGetRecord(my_desc_, &val, conflict_tx);
+            void* record = var.tryInstallNode(my_desc_, node, conflict_tx);
 
             if (record) {
                 // 【核心修复】获取锁后再次验证版本，防止 Lost Update
@@ -153,8 +230,7 @@ public:
                     if (r_entry.var == var_base) {
                         found_in_readset = true;
                         if (var.getDataVersion() != r_entry.read_ts) {
-                            std::printf("[T%zu] [WRITE-ABORT] Stale Lock! ReadVer:%lu != CurrVer:%lu\n", 
-                                        tid, r_entry.read_ts, var.getDataVersion());
+                            trace::emit<trace::kInfo>(trace::Event::WriteStale, &var, r_entry.read_ts);
                             var.abortRestoreData(record); // 立即释放锁
                             abortTransaction();
                             return;
@@ -172,7 +248,15 @@ public:
 
             resolveConflict(conflict_tx);
 
-            if (!ensureActive()) return;
+            if (!ensureActive()) {
+                delete node;
+                return;
+            }
+            if (deadline_ && deadline_->expired()) {
+                delete node;
+                abortTransaction();
+                return;
+            }
             std::this_thread::yield();
         }
     }
@@ -182,6 +266,8 @@ private:
         enterEpoch();
         read_set_.clear();
         write_set_.clear();
+        on_commit_.clear();
+        on_abort_.clear();
         start_ts_ = GlobalClock::now();
         my_desc_ = new TxDescriptor(start_ts_);
         my_desc_->status.store(TxStatus::ACTIVE, std::memory_order_release);
@@ -196,6 +282,17 @@ private:
             it->var->abortRestoreData(it->record_ptr);
         }
         cleanupResources();
+        runHandlers(false);
+    }
+
+    void runHandlers(bool committed) {
+        if (on_commit_.empty() && on_abort_.empty()) return;
+
+        std::vector<std::function<void()>> handlers = std::move(committed ? on_commit_ : on_abort_);
+        on_commit_.clear();
+        on_abort_.clear();
+
+        for (auto& handler : handlers) handler();
     }
 
     void cleanupResources() {
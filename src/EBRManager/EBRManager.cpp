@@ -2,6 +2,8 @@
 #include "EBRManager/EBRManager.hpp"
 #include "EBRManager/ThreadSlot.hpp"
 
+#include <thread>
+
 EBRManager::EBRManager() {
     // 初始化全局纪元为0
     global_epoch_.store(0, std::memory_order_relaxed);
@@ -33,18 +35,31 @@ void EBRManager::leave() {
         // 标记线程离开临界区（变为非活跃状态）
         slot->leave();
 
-        if (tryAdvanceEpoch_()) {
-            uint64_t current_global_epoch = global_epoch_.load(std::memory_order_relaxed);
+        advanceAndCollect_();
+    }
+}
+
+void EBRManager::synchronize() {
+    // 从 e 推进到 e + 2 的过程中，任何停留在 <= e 纪元的活跃线程都会阻止推进，
+    // 因此全局纪元到达 e + 2 即说明它们都已离开临界区。
+    uint64_t target = global_epoch_.load(std::memory_order_acquire) + 2;
 
-            if (current_global_epoch >= 2) {
-                uint64_t epoch_to_collect = current_global_epoch - 2;
-                collectGarbage_(epoch_to_collect);
-            }
+    while (global_epoch_.load(std::memory_order_acquire) < target) {
+        if (!advanceAndCollect_()) {
+            std::this_thread::yield();
+        }
+    }
+
+    // 推进到 e + 2 的线程负责回收纪元 e，但可能已取走链表、仍在执行 deleter。
+    // 调用前退休的对象分布在 <= e 的纪元中，等三个链表上进行中的回收都结束
+    for (auto& collectors : collectors_) {
+        while (collectors.load(std::memory_order_acquire) != 0) {
+            std::this_thread::yield();
         }
     }
 }
 
-bool EBRManager::tryAdvanceEpoch_() {
+bool EBRManager::advanceAndCollect_() {
     // 使用 acquire 内存序加载，确保我们能看到其他线程 leave 操作释放的最新状态
     uint64_t current_epoch = global_epoch_.load(std::memory_order_acquire);
     
@@ -66,13 +81,25 @@ bool EBRManager::tryAdvanceEpoch_() {
         return false; // 发现掉队者，无法推进
     }
 
+    // 推进到 current + 1 的线程回收纪元 current - 1。
+    // 先登记再推进：看到新纪元的 synchronize 一定也能看到这次登记
+    std::atomic<uint32_t>& collectors = collectors_[(current_epoch + kNumEpochLists - 1) % kNumEpochLists];
+    collectors.fetch_add(1, std::memory_order_relaxed);
+
     // 如果没有掉队者，尝试原子地将全局纪元加一
-    return global_epoch_.compare_exchange_strong(
+    bool advanced = global_epoch_.compare_exchange_strong(
         current_epoch, 
         current_epoch + 1,
         std::memory_order_acq_rel,
         std::memory_order_relaxed
     );
+
+    if (advanced && current_epoch >= 1) {
+        collectGarbage_(current_epoch - 1);
+    }
+
+    collectors.fetch_sub(1, std::memory_order_release);
+    return advanced;
 }
 
 void EBRManager::collectGarbage_(uint64_t epoch_to_collect) {
@@ -0,0 +1,61 @@
+#include "NOrecSTM/Transaction.hpp"
+
+namespace STM {
+namespace NOrec {
+
+void Transaction::begin() {
+    desc_->reset();
+    desc_->setSnapshot(GlobalSeqLock::waitEven());
+}
+
+bool Transaction::commit() {
+    auto& wset = desc_->writeSet();
+
+    // 只读事务：每次读取都对应一致的快照，直接提交
+    if (wset.empty()) {
+        desc_->reset();
+        return true;
+    }
+
+    // 1. 拿锁：快照过期时先按值验证并推进快照，再重试
+    while (!GlobalSeqLock::tryLock(desc_->snapshot())) {
+        if (!validate_()) {
+            abort();
+            return false;
+        }
+    }
+
+    // 2. 持锁写回 (此时没有其他写者，读者会因序号为奇数而等待)
+    for (auto& entry : wset) {
+        entry.committer(entry.tmvar_addr, entry.new_node);
+        entry.new_node = nullptr;
+    }
+
+    GlobalSeqLock::unlock();
+
+    desc_->commitAllocations();
+    desc_->reset();
+    return true;
+}
+
+bool Transaction::validate_() {
+    while (true) {
+        uint64_t s = GlobalSeqLock::waitEven();
+
+        for (const auto& entry : desc_->readSet()) {
+            if (!entry.checker(entry.tmvar_addr, entry.seen)) {
+                return false;
+            }
+        }
+
+        // 比对期间没有新的写回，结果可信
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (GlobalSeqLock::now() == s) {
+            desc_->setSnapshot(s);
+            return true;
+        }
+    }
+}
+
+} // namespace NOrec
+} // namespace STM
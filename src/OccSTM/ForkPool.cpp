@@ -0,0 +1,71 @@
+#include "OccSTM/ForkPool.hpp"
+
+#include <algorithm>
+
+namespace STM {
+namespace Occ {
+
+ForkPool& ForkPool::instance() {
+    static ForkPool pool;
+    return pool;
+}
+
+ForkPool::ForkPool() {
+    // 父线程自己也会执行一个子任务，工作线程数取核数 - 1
+    unsigned hw = std::thread::hardware_concurrency();
+    size_t count = std::max<size_t>(1, hw > 1 ? hw - 1 : 1);
+
+    workers_.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        workers_.emplace_back([this]() { workerLoop_(); });
+    }
+}
+
+ForkPool::~ForkPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    cv_.notify_all();
+
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+void ForkPool::submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks_.push_back(std::move(task));
+    }
+    cv_.notify_one();
+}
+
+bool ForkPool::tryRunOne() {
+    std::function<void()> task;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (tasks_.empty()) return false;
+        task = std::move(tasks_.front());
+        tasks_.pop_front();
+    }
+    task();
+    return true;
+}
+
+void ForkPool::workerLoop_() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this]() { return stop_ || !tasks_.empty(); });
+            if (stop_ && tasks_.empty()) return;
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+        task();
+    }
+}
+
+} // namespace Occ
+} // namespace STM
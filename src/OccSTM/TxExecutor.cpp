@@ -0,0 +1,167 @@
+#include "OccSTM/TxExecutor.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+namespace STM {
+namespace Occ {
+
+namespace {
+    // 当前线程所属的执行器及其工作线程编号 (非工作线程为 nullptr)
+    thread_local const TxExecutor* tl_executor = nullptr;
+    thread_local size_t tl_worker = 0;
+}
+
+size_t TxExecutor::defaultWorkerCount() {
+    return std::max<size_t>(1, std::thread::hardware_concurrency());
+}
+
+TxExecutor::TxExecutor(size_t workers, bool conflict_aware)
+    : conflict_aware_(conflict_aware)
+    , owners_(new std::atomic<uint64_t>[kOwnerSlots]) {
+    for (size_t i = 0; i < kOwnerSlots; ++i) {
+        owners_[i].store(0, std::memory_order_relaxed);
+    }
+
+    workers = std::max<size_t>(1, workers);
+    workers_.reserve(workers);
+    for (size_t i = 0; i < workers; ++i) {
+        workers_.push_back(std::make_unique<Worker>());
+    }
+
+    threads_.reserve(workers);
+    for (size_t i = 0; i < workers; ++i) {
+        threads_.emplace_back([this, i]() { workerLoop_(i); });
+    }
+}
+
+TxExecutor::~TxExecutor() {
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        stop_ = true;
+    }
+    cv_.notify_all();
+
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+// 工作线程内提交的任务留在本地队列，外部线程轮询分发
+size_t TxExecutor::pickWorker_() {
+    if (tl_executor == this) return tl_worker;
+    return next_.fetch_add(1, std::memory_order_relaxed) % workers_.size();
+}
+
+void TxExecutor::push_(size_t w, Task task) {
+    {
+        std::lock_guard<std::mutex> lock(workers_[w]->mutex);
+        workers_[w]->tasks.push_back(std::move(task));
+    }
+    pending_.fetch_add(1, std::memory_order_release);
+
+    // 在 sleep_mutex_ 下通知，避免与检查 pending_ 后入睡的线程错过唤醒
+    { std::lock_guard<std::mutex> lock(sleep_mutex_); }
+    cv_.notify_one();
+}
+
+void TxExecutor::post(std::function<void()> fn) {
+    Task task;
+    task.attempt = [fn = std::move(fn)](const void*&) {
+        fn();
+        return true;
+    };
+    push_(pickWorker_(), std::move(task));
+}
+
+bool TxExecutor::popLocal_(size_t w, Task& task) {
+    std::lock_guard<std::mutex> lock(workers_[w]->mutex);
+    if (workers_[w]->tasks.empty()) {
+        // 本地队列取空：放弃所有认领，之后的中止不再迁移过来
+        workers_[w]->generation.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    task = std::move(workers_[w]->tasks.back());
+    workers_[w]->tasks.pop_back();
+    return true;
+}
+
+bool TxExecutor::steal_(size_t w, Task& task) {
+    for (size_t k = 1; k < workers_.size(); ++k) {
+        Worker& victim = *workers_[(w + k) % workers_.size()];
+
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (victim.tasks.empty()) continue;
+
+        task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        return true;
+    }
+    return false;
+}
+
+bool TxExecutor::findOwner_(const void* conflict, size_t w, size_t& owner) {
+    size_t hash = std::hash<const void*>{}(conflict);
+    uint32_t fingerprint = static_cast<uint32_t>((reinterpret_cast<uintptr_t>(conflict) * 0x9E3779B97F4A7C15ull) >> 32);
+    auto& slot = owners_[hash % kOwnerSlots];
+
+    uint64_t word = slot.load(std::memory_order_relaxed);
+    size_t current = static_cast<size_t>((word >> 16) & 0xffff);
+
+    // 同一个变量、属主仍在处理认领时的那批任务
+    if (word != 0 && static_cast<uint32_t>(word >> 32) == fingerprint && current - 1 < workers_.size()) {
+        uint32_t generation = workers_[current - 1]->generation.load(std::memory_order_relaxed);
+        if ((generation & 0xffff) == (word & 0xffff)) {
+            owner = current - 1;
+            return true;
+        }
+    }
+
+    slot.store(packOwner_(fingerprint, w, workers_[w]->generation.load(std::memory_order_relaxed)),
+               std::memory_order_relaxed);
+    return false;
+}
+
+void TxExecutor::run_(size_t w, Task task) {
+    while (true) {
+        const void* conflict = nullptr;
+        if (task.attempt(conflict)) return;
+
+        if (conflict_aware_ && conflict != nullptr && !task.migrated) {
+            size_t owner;
+            if (findOwner_(conflict, w, owner) && owner != w) {
+                // 排到属主的队尾，与在同一变量上中止的其他任务串行
+                task.migrated = true;
+                migrations_.fetch_add(1, std::memory_order_relaxed);
+                push_(owner, std::move(task));
+                return;
+            }
+        }
+
+        std::this_thread::yield();
+    }
+}
+
+void TxExecutor::workerLoop_(size_t w) {
+    tl_executor = this;
+    tl_worker = w;
+
+    while (true) {
+        Task task;
+        if (popLocal_(w, task) || steal_(w, task)) {
+            pending_.fetch_sub(1, std::memory_order_acq_rel);
+            run_(w, std::move(task));
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        if (pending_.load(std::memory_order_acquire) > 0) continue;
+        if (stop_) return;
+        cv_.wait(lock, [this]() { return stop_ || pending_.load(std::memory_order_acquire) > 0; });
+    }
+}
+
+} // namespace Occ
+} // namespace STM
@@ -0,0 +1,90 @@
+#include "RingSTM/Transaction.hpp"
+
+namespace STM {
+namespace Ring {
+
+void Transaction::begin() {
+    desc_->reset();
+
+    // 从最近一个已完成写回的槽位开始，之后的提交都要用签名验证
+    auto& ring = CommitRing::instance();
+    uint64_t s = ring.index();
+    while (s > 0 && !ring.isComplete(s)) {
+        --s;
+    }
+    desc_->setStart(s);
+}
+
+bool Transaction::commit() {
+    auto& wset = desc_->writeSet();
+
+    // 只读事务：每次读之后都已验证过，直接提交
+    if (wset.empty()) {
+        desc_->reset();
+        return true;
+    }
+
+    auto& ring = CommitRing::instance();
+
+    // 1. 验证到最新位置后抢占下一个槽位；抢占失败说明有新提交，重新验证
+    uint64_t ts;
+    while (true) {
+        uint64_t upto;
+        if (!validate_(upto)) {
+            abort();
+            return false;
+        }
+        if (ring.tryClaim(upto)) {
+            ts = upto + 1;
+            break;
+        }
+    }
+
+    // 2. 发布写签名，之后开始的读者都能看到本次提交
+    ring.publish(ts, desc_->writeSignature());
+
+    // 3. 按提交顺序写回
+    ring.waitComplete(ts - 1);
+    for (auto& entry : wset) {
+        entry.committer(entry.tmvar_addr, entry.new_node, ts);
+        entry.new_node = nullptr;
+    }
+    ring.markComplete(ts);
+
+    desc_->commitAllocations();
+    desc_->reset();
+    return true;
+}
+
+bool Transaction::validate_(uint64_t& upto) {
+    auto& ring = CommitRing::instance();
+    uint64_t idx = ring.index();
+    uint64_t start = desc_->start();
+    upto = idx;
+
+    if (idx == start) return true;
+
+    auto& rsig = desc_->readSignature();
+    if (!rsig.empty()) {
+        // 槽位已被覆盖，无法判断是否冲突
+        if (idx - start >= CommitRing::kRingSize) return false;
+
+        for (uint64_t i = idx; i > start; --i) {
+            bool conflict = false;
+            if (!ring.checkEntry(i, rsig, conflict) || conflict) {
+                return false;
+            }
+        }
+    }
+
+    // 推进 start 到最近一个已完成写回的槽位 (写回按序完成)
+    uint64_t s = idx;
+    while (s > start && !ring.isComplete(s)) {
+        --s;
+    }
+    desc_->setStart(s);
+    return true;
+}
+
+} // namespace Ring
+} // namespace STM
@@ -4,34 +4,69 @@
 #include "ThreadHeap/Slab.hpp"
 #include "common/GlobalConfig.hpp"
 #include <cassert>
+#include <mutex>
+
+namespace {
+
+// 遗弃的 Slab：线程退出时仍有存活块的 Slab 挂在这里，由之后需要新 Slab 的同尺寸 Pool 收养。
+// 只在线程退出与切新 Slab 时访问，一把锁即可；故意不析构，线程局部的 Pool 可能在静态对象之后退出
+struct OrphanSlabs {
+    std::mutex mutex;
+    SlabList list;
+    size_t count = 0;
+};
+
+OrphanSlabs& orphans() {
+    static OrphanSlabs* instance = new OrphanSlabs();
+    return *instance;
+}
+
+}
 
 SizeClassPool::~SizeClassPool() {
-    auto& central = CentralHeap::GetInstance();
-
-    // [KNOWN LIMITATION / 已知缺陷]
-    // 警告：当前析构逻辑采取“暴力回收”策略。
-    // 当线程退出时，无论 Slab 中是否有对象仍被其他线程持有，都会强制将内存归还给 CentralHeap。
-    //
-    // 风险点：如果线程 T2 仍持有由本线程(T1)分配的内存，T1 退出后，
-    //        T2 尝试访问或释放(free)该内存时会触发 Use-After-Free (SegFault)。
-    //
-    // 适用场景：仅适用于线程池架构（线程不频繁销毁）或无跨线程内存传递的简单场景。
-    
+    // 线程退出时，只有已经完全空闲的 Slab 才能归还给 CentralHeap。
+    // 仍有存活对象的 Slab (例如还挂在 EBR 垃圾链表上、或被其他线程持有的节点)
+    // 如果被强制归还，Chunk 会被别的线程重新切分，造成 Use-After-Free。
+    // 这类 Slab 被"遗弃"：不再属于任何 Pool，之后的释放都走远程链表，
+    // 直到别的线程的同尺寸 Pool 收养它 (见 allocFromOrphan_)，Chunk 因此不会随线程更替无限泄漏。
+
     if(current_slab_ != nullptr) {
-        central.returnChunk(reinterpret_cast<void*>(current_slab_));
+        releaseOrAbandon_(current_slab_);
+        current_slab_ = nullptr;
     }
 
     while(!partial_list_.empty()) {
-        Slab* slab = partial_list_.pop_front();
-        central.returnChunk(reinterpret_cast<void*>(slab));
+        releaseOrAbandon_(partial_list_.pop_front());
     }
 
     while(!full_list_.empty()) {
-        Slab* slab = full_list_.pop_front();
-        central.returnChunk(reinterpret_cast<void*>(slab));
+        releaseOrAbandon_(full_list_.pop_front());
     }
 }
 
+void SizeClassPool::releaseOrAbandon_(Slab* slab) {
+    slab->reclaimRemoteMemory();
+
+    if(slab->isEmpty()) {
+        slab->Destroy();
+        CentralHeap::GetInstance().returnChunk(reinterpret_cast<void*>(slab));
+    }
+    else {
+        slab->abandon();
+
+        OrphanSlabs& o = orphans();
+        std::lock_guard<std::mutex> lock(o.mutex);
+        o.list.push_back(slab);
+        o.count++;
+    }
+}
+
+size_t SizeClassPool::abandonedSlabCount() {
+    OrphanSlabs& o = orphans();
+    std::lock_guard<std::mutex> lock(o.mutex);
+    return o.count;
+}
+
 
 void* SizeClassPool::allocate() {
     if(current_slab_) {
@@ -51,6 +86,9 @@ void* SizeClassPool::allocate() {
         if(ptr) return ptr;
     }
 
+    void* ptr = allocFromOrphan_();
+    if(ptr) return ptr;
+
     return allocFromNew_();
 }
 
@@ -115,6 +153,44 @@ void* SizeClassPool::allocFromPartial_() {
     return nullptr;
 }
 
+// 收养同尺寸的遗弃 Slab：块已全部释放的直接重新切分，有空闲块的接着用，仍然满的放进 full_list_ 等待救援
+[[nodiscard]] void* SizeClassPool::allocFromOrphan_() {
+    OrphanSlabs& o = orphans();
+
+    while(true) {
+        Slab* slab = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(o.mutex);
+            for(Slab* curr = o.list.front(); curr != nullptr; curr = curr->next) {
+                if(curr->block_size() == block_size_) {
+                    o.list.remove(curr);
+                    o.count--;
+                    slab = curr;
+                    break;
+                }
+            }
+        }
+        if(slab == nullptr) return nullptr;
+
+        slab->reclaimRemoteMemory();
+
+        if(slab->isEmpty()) {
+            slab->Destroy();
+            current_slab_ = Slab::CreateAt(reinterpret_cast<void*>(slab), this, block_size_);
+            return current_slab_->allocate();
+        }
+
+        slab->adopt(this);
+        if(slab->isFull()) {
+            full_list_.push_back(slab);
+            continue;
+        }
+
+        current_slab_ = slab;
+        return current_slab_->allocate();
+    }
+}
+
 void* SizeClassPool::allocFromNew_() {
     void* chunk = thread_chunk_cache_->fetchChunk(); 
     if(chunk == nullptr)
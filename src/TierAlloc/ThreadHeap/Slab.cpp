@@ -14,7 +14,7 @@ Slab* Slab::CreateAt(void *chunk_start, SizeClassPool *pool, uint32_t block_size
 
     Slab* meta = new (chunk_start) Slab();
 
-    meta->owner_ = pool;
+    meta->owner_.store(pool, std::memory_order_relaxed);
     meta->block_size_ = block_size;
 
     uintptr_t base = reinterpret_cast<uintptr_t>(chunk_start); 
@@ -104,7 +104,7 @@ void* Slab::allocFromBump_() {
 void Slab::Destroy() {
 #ifdef NDEBUG
     // 在 Release 模式下，只清理最危险的指针，性能开销最小
-    this->owner_ = nullptr; 
+    this->owner_.store(nullptr, std::memory_order_relaxed);
 #else
     // 在 Debug 模式下，用“毒药”值填充整个元数据区，
     constexpr size_t head_size = (sizeof(Slab) + kCacheLineSize - 1) & ~(kCacheLineSize - 1);
@@ -112,6 +112,19 @@ void Slab::Destroy() {
 #endif
 }
 
+// 所属线程退出时仍有存活对象：断开与 Pool 的关联。
+// 之后任何线程释放其中的块都会走 freeRemote，直到同尺寸的 Pool 收养它 (见 SizeClassPool)
+void Slab::abandon() {
+    owner_.store(nullptr, std::memory_order_relaxed);
+    prev = nullptr;
+    next = nullptr;
+}
+
+// 收养遗弃的 Slab：只有新 owner 所在线程会看到 owner() 等于自己的 Pool，其他线程照常走 freeRemote
+void Slab::adopt(SizeClassPool* pool) {
+    owner_.store(pool, std::memory_order_relaxed);
+}
+
 uint32_t Slab::block_size() const {
     return block_size_;
 }
@@ -125,7 +138,7 @@ uint32_t Slab::allocated_count() const {
 }
 
 SizeClassPool* Slab::owner() const {
-    return owner_;
+    return owner_.load(std::memory_order_relaxed);
 }
 
 bool Slab::isFull() const {
@@ -44,7 +44,11 @@ void ThreadHeap::deallocate(void *ptr) noexcept{
             return;
         }
     }
-    // 2.大对象释放
+    // 2.批量区中的对象随整块一起归还
+    else if(header->type == ChunkHeader::Type::BULK) {
+        return;
+    }
+    // 3.大对象释放
     else {
         Span* span = static_cast<Span*>(header);
         CentralHeap::GetInstance().freeLarge(span, span->size());
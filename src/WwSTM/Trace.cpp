@@ -0,0 +1,227 @@
+#include "WwSTM/Trace.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+
+namespace STM {
+namespace Ww {
+namespace trace {
+
+namespace {
+
+    constexpr char kMagic[8] = {'W', 'W', 'T', 'R', 'A', 'C', 'E', '1'};
+
+    constexpr const char* kEventNames[] = {
+        "VarConstruct",
+        "VarDestruct",
+        "ReadStable",
+        "ReadOwner",
+        "ReadCommitted",
+        "ReadSnapshot",
+        "WriteInit",
+        "WriteReentrant",
+        "WriteConflict",
+        "WriteWait",
+        "WriteSteal",
+        "WriteLocked",
+        "WriteRetry",
+        "WriteStale",
+        "CommitStart",
+        "CommitDone",
+        "CommitNoRecord",
+        "AbortStart",
+        "AbortRestored",
+        "AbortStolen",
+        "FatalBadVar",
+        "FatalNullHead",
+    };
+    static_assert(sizeof(kEventNames) / sizeof(kEventNames[0]) == static_cast<size_t>(Event::kCount),
+                  "every trace event needs a name");
+
+    // 所有线程环的登记表；环随进程存活，线程退出后仍可导出。
+    // 退出线程的环进入 idle，由之后的新线程复用，环的总数不超过同时存活的线程数
+    struct Registry {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<Ring>> rings;
+        std::vector<Ring*> idle;
+        uint32_t next_id = 0;
+    };
+
+    Registry& registry() {
+        static Registry* r = new Registry();
+        return *r;
+    }
+
+    std::vector<Ring*> snapshotRings() {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+
+        std::vector<Ring*> rings;
+        rings.reserve(r.rings.size());
+        for (auto& ring : r.rings) rings.push_back(ring.get());
+        return rings;
+    }
+
+}
+
+const char* eventName(Event e) noexcept {
+    size_t i = static_cast<size_t>(e);
+    return i < static_cast<size_t>(Event::kCount) ? kEventNames[i] : "Unknown";
+}
+
+void Ring::copyTo(std::vector<Record>& out) const {
+    uint64_t end = head_.load(std::memory_order_acquire);
+    uint64_t begin = end > kCapacity ? end - kCapacity : 0;
+
+    for (uint64_t pos = begin; pos < end; ++pos) {
+        const Slot& slot = slots_[pos & (kCapacity - 1)];
+
+        // 所属线程可能正在用更新的事件覆盖这个槽：前后两次序号都等于写完 pos 时的值才有效
+        uint64_t seq = slot.seq.load(std::memory_order_acquire);
+        if (seq != 2 * pos + 2) continue;
+
+        uint64_t words[kWords];
+        for (size_t i = 0; i < kWords; ++i) words[i] = slot.words[i].load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.seq.load(std::memory_order_relaxed) != seq) continue;
+
+        Record r;
+        std::memcpy(&r, words, sizeof(r));
+        out.push_back(r);
+    }
+}
+
+namespace {
+
+    // 线程退出时把环归还登记表
+    struct LocalRing {
+        Ring* ring = nullptr;
+
+        ~LocalRing() {
+            if (!ring) return;
+            Registry& r = registry();
+            std::lock_guard<std::mutex> lock(r.mutex);
+            r.idle.push_back(ring);
+            ring = nullptr;
+        }
+    };
+
+    thread_local LocalRing tl_ring;
+
+}
+
+Ring& localRing() {
+    if (tl_ring.ring) return *tl_ring.ring;
+
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    uint32_t id = r.next_id++;
+
+    if (!r.idle.empty()) {
+        tl_ring.ring = r.idle.back();
+        r.idle.pop_back();
+        tl_ring.ring->rebind(id);
+    }
+    else {
+        r.rings.push_back(std::make_unique<Ring>(id));
+        tl_ring.ring = r.rings.back().get();
+    }
+    return *tl_ring.ring;
+}
+
+std::vector<Record> collect() {
+    std::vector<Record> records;
+    for (Ring* ring : snapshotRings()) ring->copyTo(records);
+
+    std::stable_sort(records.begin(), records.end(),
+                     [](const Record& x, const Record& y) { return x.ts_ns < y.ts_ns; });
+    return records;
+}
+
+void clear() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    for (auto& ring : r.rings) ring->reset();
+}
+
+size_t ringCount() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    return r.rings.size();
+}
+
+void writeBinary(std::ostream& out) {
+    writeBinary(out, collect());
+}
+
+void writeBinary(std::ostream& out, const std::vector<Record>& records) {
+    uint64_t count = records.size();
+    out.write(kMagic, sizeof(kMagic));
+    out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    if (count > 0) {
+        out.write(reinterpret_cast<const char*>(records.data()), static_cast<std::streamsize>(count * sizeof(Record)));
+    }
+}
+
+bool readBinary(std::istream& in, std::vector<Record>& records) {
+    char magic[sizeof(kMagic)];
+    uint64_t count = 0;
+
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0) return false;
+    if (!in.read(reinterpret_cast<char*>(&count), sizeof(count))) return false;
+
+    // 记录数来自文件，截断或损坏时可能大得离谱：按块读取，实际读到的数据不够就失败，不预先按 count 分配
+    constexpr uint64_t kChunk = 4096;
+    records.clear();
+    while (records.size() < count) {
+        size_t have = records.size();
+        size_t n = static_cast<size_t>(std::min<uint64_t>(kChunk, count - have));
+        records.resize(have + n);
+        if (!in.read(reinterpret_cast<char*>(records.data() + have), static_cast<std::streamsize>(n * sizeof(Record)))) {
+            records.clear();
+            return false;
+        }
+    }
+    return true;
+}
+
+void decodeToText(const std::vector<Record>& records, std::ostream& out) {
+    uint64_t base = records.empty() ? 0 : records.front().ts_ns;
+    for (const Record& r : records) {
+        out << '+' << (r.ts_ns - base) << "ns [T" << r.thread << "] "
+            << eventName(static_cast<Event>(r.event))
+            << " a=0x" << std::hex << r.a << " b=0x" << r.b << std::dec << '\n';
+    }
+}
+
+// Chrome trace 格式 (chrome://tracing、Perfetto)：每条事件是一个线程内的瞬时事件，时间单位为微秒
+void decodeToChromeJson(const std::vector<Record>& records, std::ostream& out) {
+    uint64_t base = records.empty() ? 0 : records.front().ts_ns;
+
+    out << "{\"traceEvents\":[";
+    for (size_t i = 0; i < records.size(); ++i) {
+        const Record& r = records[i];
+        uint64_t ns = r.ts_ns - base;
+
+        if (i > 0) out << ',';
+        out << "\n{\"name\":\"" << eventName(static_cast<Event>(r.event))
+            << "\",\"ph\":\"i\",\"s\":\"t\",\"pid\":0,\"tid\":" << r.thread
+            << ",\"ts\":" << ns / 1000 << '.';
+
+        // 小数部分补足三位
+        uint64_t frac = ns % 1000;
+        out << (frac < 100 ? "0" : "") << (frac < 10 ? "0" : "") << frac;
+
+        out << ",\"args\":{\"a\":\"0x" << std::hex << r.a << "\",\"b\":\"0x" << r.b << std::dec << "\"}}";
+    }
+    out << "\n]}\n";
+}
+
+} // namespace trace
+} // namespace Ww
+} // namespace STM
@@ -2,6 +2,7 @@
 #include <thread>
 #include <vector>
 #include <atomic>
+#include <chrono>
 #include <new> // for placement new
 
 // 引入你的头文件路径
@@ -176,4 +177,77 @@ TEST_F(EBRManagerTest, CustomDeleterWithStandardHeap) {
 
     cleanUpGarbage();
     EXPECT_EQ(TrackedObject::alive_count.load(), 0);
-}
\ No newline at end of file
+}
+// ==========================================
+// 6. 静默屏障
+// ==========================================
+
+// synchronize 必须等待调用前已进入临界区的线程离开
+TEST_F(EBRManagerTest, SynchronizeWaitsForActiveReaders) {
+    EBRManager* mgr = EBRManager::instance();
+
+    std::atomic<bool> reader_inside{false};
+    std::atomic<bool> reader_left{false};
+    std::atomic<bool> release_reader{false};
+
+    std::thread reader([&]() {
+        mgr->enter();
+        reader_inside.store(true);
+        while (!release_reader.load()) std::this_thread::yield();
+        reader_left.store(true);
+        mgr->leave();
+    });
+
+    while (!reader_inside.load()) std::this_thread::yield();
+
+    std::thread releaser([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        release_reader.store(true);
+    });
+
+    mgr->synchronize();
+    EXPECT_TRUE(reader_left.load());
+
+    reader.join();
+    releaser.join();
+}
+
+// 其他线程已取走链表、deleter 仍在执行时，synchronize 也要等它执行完
+namespace {
+    std::atomic<bool> g_slow_started{false};
+    std::atomic<bool> g_slow_finished{false};
+
+    void slowDeleter(void*) {
+        g_slow_started.store(true);
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        g_slow_finished.store(true);
+    }
+}
+
+TEST_F(EBRManagerTest, SynchronizeWaitsForInFlightCollection) {
+    EBRManager* mgr = EBRManager::instance();
+    static int dummy;
+
+    g_slow_started = false;
+    g_slow_finished = false;
+
+    mgr->enter();
+    mgr->retire(&dummy, slowDeleter);
+    mgr->leave();
+
+    // 另一个线程不断推进纪元，直到它开始执行 deleter
+    std::thread collector([&]() {
+        while (!g_slow_started.load()) {
+            mgr->enter();
+            mgr->leave();
+            std::this_thread::yield();
+        }
+    });
+
+    while (!g_slow_started.load()) std::this_thread::yield();
+
+    mgr->synchronize();
+    EXPECT_TRUE(g_slow_finished.load());
+
+    collector.join();
+}
@@ -0,0 +1,197 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include <string>
+#include "NOrecSTM/STM.hpp"
+
+using namespace STM::NOrec;
+
+// ==========================================
+// 1. 单线程事务语义
+// ==========================================
+TEST(NOrecSTMTest, BasicReadWrite) {
+    Var<int> account(100);
+
+    STM::NOrec::atomically([&](Transaction& tx) {
+        tx.store(account, tx.load(account) + 50);
+    });
+
+    int balance = STM::NOrec::atomically([&](Transaction& tx) {
+        return tx.load(account);
+    });
+    EXPECT_EQ(balance, 150);
+}
+
+TEST(NOrecSTMTest, ReadYourOwnWrites) {
+    Var<std::string> name("init");
+    TxDescriptor desc;
+    Transaction tx(&desc);
+
+    tx.begin();
+    EXPECT_EQ(tx.load(name), "init");
+    tx.store(name, std::string("draft"));
+    tx.store(name, std::string("final"));
+    EXPECT_EQ(tx.load(name), "final");
+    EXPECT_TRUE(tx.commit());
+
+    EXPECT_EQ(name.loadHead()->payload, "final");
+}
+
+// 读过的变量被别人改掉：按值验证失败，写事务不能提交
+TEST(NOrecSTMTest, ConflictingCommitIsRejected) {
+    Var<int> x(10);
+    Var<int> y(20);
+
+    TxDescriptor desc, desc_other;
+    Transaction tx(&desc);
+    Transaction other(&desc_other);
+
+    tx.begin();
+    EXPECT_EQ(tx.load(x), 10);
+
+    other.begin();
+    other.store(x, 11);
+    EXPECT_TRUE(other.commit());
+
+    tx.store(y, 21);
+    EXPECT_FALSE(tx.commit());
+    EXPECT_EQ(y.loadHead()->payload, 20);
+}
+
+// 别人只改了无关变量：序号变了，但按值验证通过，快照被推进
+TEST(NOrecSTMTest, UnrelatedCommitOnlyExtendsSnapshot) {
+    Var<int> x(1);
+    Var<int> z(5);
+
+    TxDescriptor desc, desc_other;
+    Transaction tx(&desc);
+    Transaction other(&desc_other);
+
+    tx.begin();
+    EXPECT_EQ(tx.load(x), 1);
+
+    other.begin();
+    other.store(z, 6);
+    EXPECT_TRUE(other.commit());
+
+    EXPECT_EQ(tx.load(z), 6);
+    tx.store(x, 2);
+    EXPECT_TRUE(tx.commit());
+    EXPECT_EQ(x.loadHead()->payload, 2);
+}
+
+// 别人把相同的值写回：节点换了，但值没变，按值验证通过
+TEST(NOrecSTMTest, SilentStoreDoesNotAbortReader) {
+    Var<std::string> x("same");
+    Var<int> y(0);
+
+    TxDescriptor desc, desc_other;
+    Transaction tx(&desc);
+    Transaction other(&desc_other);
+
+    EBRManager::instance()->enter();
+    tx.begin();
+    EXPECT_EQ(tx.load(x), "same");
+
+    other.begin();
+    other.store(x, std::string("same"));
+    EXPECT_TRUE(other.commit());
+
+    tx.store(y, 1);
+    EXPECT_TRUE(tx.commit());
+    EBRManager::instance()->leave();
+    EXPECT_EQ(y.loadHead()->payload, 1);
+}
+
+TEST(NOrecSTMTest, ReadAfterConflictingCommitRetries) {
+    Var<int> x(1);
+    Var<int> y(1);
+
+    TxDescriptor desc, desc_other;
+    Transaction tx(&desc);
+    Transaction other(&desc_other);
+
+    tx.begin();
+    tx.load(x);
+
+    other.begin();
+    other.store(x, 2);
+    other.store(y, 2);
+    EXPECT_TRUE(other.commit());
+
+    EXPECT_THROW(tx.load(y), RetryException);
+    tx.abort();
+}
+
+// ==========================================
+// 2. 并发测试
+// ==========================================
+TEST(NOrecSTMTest, ConcurrentCounter) {
+    Var<int> counter(0);
+
+    const int NUM_THREADS = 4;
+    const int INC_PER_THREAD = 1000;
+
+    std::vector<std::thread> workers;
+    for (int i = 0; i < NUM_THREADS; ++i) {
+        workers.emplace_back([&]() {
+            for (int j = 0; j < INC_PER_THREAD; ++j) {
+                STM::NOrec::atomically([&](Transaction& tx) {
+                    tx.store(counter, tx.load(counter) + 1);
+                });
+            }
+        });
+    }
+    for (auto& t : workers) t.join();
+
+    int final_val = STM::NOrec::atomically([&](Transaction& tx) {
+        return tx.load(counter);
+    });
+    EXPECT_EQ(final_val, NUM_THREADS * INC_PER_THREAD);
+}
+
+TEST(NOrecSTMTest, ConcurrentTransfersPreserveTotal) {
+    const int NUM_ACCOUNTS = 16;
+    const int NUM_THREADS = 4;
+    const int OPS_PER_THREAD = 500;
+
+    std::vector<Var<int>*> accounts;
+    for (int i = 0; i < NUM_ACCOUNTS; ++i) accounts.push_back(new Var<int>(100));
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < NUM_THREADS; ++t) {
+        workers.emplace_back([&, t]() {
+            for (int i = 0; i < OPS_PER_THREAD; ++i) {
+                int from = (t * 7 + i) % NUM_ACCOUNTS;
+                int to = (t * 13 + i * 3 + 1) % NUM_ACCOUNTS;
+                if (from == to) continue;
+
+                STM::NOrec::atomically([&](Transaction& tx) {
+                    int a = tx.load(*accounts[from]);
+                    int b = tx.load(*accounts[to]);
+                    tx.store(*accounts[from], a - 1);
+                    tx.store(*accounts[to], b + 1);
+                });
+
+                if (i % 50 == 0) {
+                    int total = STM::NOrec::atomically([&](Transaction& tx) {
+                        int sum = 0;
+                        for (auto* acc : accounts) sum += tx.load(*acc);
+                        return sum;
+                    });
+                    EXPECT_EQ(total, NUM_ACCOUNTS * 100);
+                }
+            }
+        });
+    }
+    for (auto& t : workers) t.join();
+
+    int total = STM::NOrec::atomically([&](Transaction& tx) {
+        int sum = 0;
+        for (auto* acc : accounts) sum += tx.load(*acc);
+        return sum;
+    });
+    EXPECT_EQ(total, NUM_ACCOUNTS * 100);
+
+    for (auto* acc : accounts) delete acc;
+}
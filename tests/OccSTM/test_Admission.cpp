@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "OccSTM/STM.hpp"
+
+using namespace STM::Occ;
+
+using ThrottledTx = BasicTransaction<ThrottledPolicy>;
+
+template<typename T>
+using ThrottledVar = TMVar<T, ThrottledPolicy>;
+
+// 1. AIMD：中止风暴时上限减半，恢复后逐窗口加一
+TEST(OccAdmissionTest, LimitFollowsAbortRatio) {
+    AdaptiveAdmission::reset();
+    const int max_limit = AdaptiveAdmission::metrics().max_limit;
+
+    for (uint32_t i = 0; i < AdaptiveAdmission::kWindow * 4; ++i) AdaptiveAdmission::onAbort();
+
+    auto stormy = AdaptiveAdmission::metrics();
+    EXPECT_EQ(stormy.limit, std::max(1, max_limit / 16));
+    EXPECT_GT(stormy.window_abort_ratio, AdaptiveAdmission::kHighAbortRatio);
+    EXPECT_GE(stormy.aborts, AdaptiveAdmission::kWindow * 4 - AdaptiveAdmission::kFlushBatch);
+
+    for (int w = 0; w < max_limit + 1; ++w) {
+        for (uint32_t i = 0; i < AdaptiveAdmission::kWindow; ++i) AdaptiveAdmission::onCommit();
+    }
+
+    auto calm = AdaptiveAdmission::metrics();
+    EXPECT_EQ(calm.limit, max_limit);
+    EXPECT_LT(calm.window_abort_ratio, AdaptiveAdmission::kLowAbortRatio);
+
+    AdaptiveAdmission::reset();
+}
+
+// 2. 令牌只发给上一次尝试写过东西却中止了的事务
+TEST(OccAdmissionTest, OnlyRetryingWritersTakeTokens) {
+    AdaptiveAdmission::reset();
+    ThrottledVar<int> x(0);
+    int attempts = 0;
+    int in_flight_on_retry = -1;
+
+    STM::atomically<ThrottledPolicy>([&](ThrottledTx& tx) {
+        if (attempts++ == 0) {
+            EXPECT_EQ(AdaptiveAdmission::metrics().in_flight, 0);
+            tx.store(x, 1);
+            throw RetryException();
+        }
+        in_flight_on_retry = AdaptiveAdmission::metrics().in_flight;
+        tx.store(x, 2);
+    });
+
+    EXPECT_EQ(in_flight_on_retry, 1);
+    EXPECT_EQ(AdaptiveAdmission::metrics().in_flight, 0);
+    EXPECT_EQ(x.unsafeLoad(), 2);
+
+    // 只读事务中止后不排队
+    attempts = 0;
+    STM::atomically<ThrottledPolicy>([&](ThrottledTx& tx) {
+        int v = tx.load(x);
+        if (attempts++ == 0) throw RetryException();
+        EXPECT_EQ(AdaptiveAdmission::metrics().in_flight, 0);
+        return v;
+    });
+
+    AdaptiveAdmission::reset();
+}
+
+// 3. 高争用计数器：结果精确，结束后令牌全部归还
+TEST(OccAdmissionTest, ContendedCounterStaysExact) {
+    AdaptiveAdmission::reset();
+    ThrottledVar<long> counter(0);
+    std::vector<ThrottledVar<long>*> padding;
+    for (int i = 0; i < 4; ++i) padding.push_back(new ThrottledVar<long>(0L));
+
+    const int kThreads = 4;
+    const int kOps = 2000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < kOps; ++i) {
+                STM::atomically<ThrottledPolicy>([&](ThrottledTx& tx) {
+                    long v = tx.load(counter);
+                    tx.store(*padding[t], tx.load(*padding[t]) + 1);
+                    std::this_thread::yield();
+                    tx.store(counter, v + 1);
+                });
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+
+    EXPECT_EQ(counter.unsafeLoad(), static_cast<long>(kThreads) * kOps);
+    auto m = AdaptiveAdmission::metrics();
+    EXPECT_EQ(m.in_flight, 0);
+    EXPECT_GE(m.limit, 1);
+    EXPECT_LE(m.limit, m.max_limit);
+
+    for (auto* p : padding) delete p;
+    AdaptiveAdmission::reset();
+}
+
+// 4. 令牌被占满时 tryAtomically 不会越过期限等待
+TEST(OccAdmissionTest, TryAtomicallyGivesUpWaitingForToken) {
+    AdaptiveAdmission::reset();
+    ThrottledVar<int> x(0);
+
+    const int limit = AdaptiveAdmission::metrics().limit;
+    for (int i = 0; i < limit; ++i) AdaptiveAdmission::acquire([] { return false; });
+
+    int attempts = 0;
+    auto start = std::chrono::steady_clock::now();
+    auto r = STM::tryAtomically<ThrottledPolicy>(STM::TxDeadline::after(std::chrono::milliseconds(20)),
+        [&](ThrottledTx& tx) {
+            ++attempts;
+            tx.store(x, 1);
+            throw RetryException();
+        });
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_EQ(r.outcome, STM::TxOutcome::TimedOut);
+    EXPECT_EQ(attempts, 1);
+    EXPECT_LT(elapsed, std::chrono::seconds(5));
+    EXPECT_EQ(x.unsafeLoad(), 0);
+
+    for (int i = 0; i < limit; ++i) AdaptiveAdmission::release();
+
+    // 上一次写过却中止：本线程的下一个事务照常申请令牌并提交
+    STM::atomically<ThrottledPolicy>([&](ThrottledTx& tx) { tx.store(x, 2); });
+    EXPECT_EQ(x.unsafeLoad(), 2);
+    EXPECT_EQ(AdaptiveAdmission::metrics().in_flight, 0);
+
+    AdaptiveAdmission::reset();
+}
+
+// 5. onCommit 回调抛出：只上报一次提交，不再记一次中止
+TEST(OccAdmissionTest, ThrowingCommitHandlerReportsOnce) {
+    AdaptiveAdmission::reset();
+    ThrottledVar<int> x(0);
+
+    // 新线程的本地批次为空，2 * kFlushBatch 个结果恰好全部合入全局计数
+    std::thread worker([&] {
+        for (uint32_t i = 0; i < 2 * AdaptiveAdmission::kFlushBatch; ++i) {
+            EXPECT_THROW(STM::atomically<ThrottledPolicy>([&](ThrottledTx& tx) {
+                tx.onCommit([] { throw std::runtime_error("handler"); });
+                tx.store(x, tx.load(x) + 1);
+            }), std::runtime_error);
+        }
+    });
+    worker.join();
+
+    auto m = AdaptiveAdmission::metrics();
+    EXPECT_EQ(m.commits, 2 * AdaptiveAdmission::kFlushBatch);
+    EXPECT_EQ(m.aborts, 0u);
+    EXPECT_EQ(m.in_flight, 0);
+    EXPECT_EQ(x.unsafeLoad(), static_cast<int>(2 * AdaptiveAdmission::kFlushBatch));
+
+    AdaptiveAdmission::reset();
+}
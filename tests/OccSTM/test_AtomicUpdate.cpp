@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "OccSTM/STM.hpp"
+
+using namespace STM::Occ;
+
+namespace {
+
+template<typename Policy>
+int readCommitted(TMVar<int, Policy>& var) {
+    return STM::atomically<Policy>([&](BasicTransaction<Policy>& tx) { return tx.load(var); });
+}
+
+}
+
+// ==========================================
+// 1. var.atomicUpdate
+// ==========================================
+TEST(OccAtomicUpdateTest, ReturnsAndPublishesNewValue) {
+    STM::Var<int> x(40);
+
+    EXPECT_EQ(x.atomicUpdate([](const int& v) { return v + 2; }), 42);
+    EXPECT_EQ(readCommitted(x), 42);
+}
+
+// 对读过该变量的事务而言，快路径更新与普通提交一样会使其验证失败
+TEST(OccAtomicUpdateTest, InvalidatesConcurrentReaders) {
+    STM::Var<int> x(1), y(0);
+
+    TransactionDescriptor desc;
+    Transaction tx(&desc);
+
+    tx.begin();
+    EXPECT_EQ(tx.load(x), 1);
+
+    x.atomicUpdate([](const int& v) { return v + 1; });
+
+    tx.store(y, 1);
+    EXPECT_FALSE(tx.commit());
+    EXPECT_EQ(readCommitted(y), 0);
+}
+
+TEST(OccAtomicUpdateTest, ExceptionLeavesValueUnchanged) {
+    STM::Var<int> x(5);
+
+    EXPECT_THROW(x.atomicUpdate([](const int&) -> int { throw std::runtime_error("reject"); }),
+                 std::runtime_error);
+
+    // 条带锁已释放
+    EXPECT_EQ(x.atomicUpdate([](const int& v) { return v * 2; }), 10);
+}
+
+// ==========================================
+// 2. 单变量事务的提交快路径
+// ==========================================
+TEST(OccAtomicUpdateTest, SingleVarCommitDetectsConflict) {
+    STM::Var<int> x(0);
+
+    TransactionDescriptor desc, desc_other;
+    Transaction tx(&desc);
+    Transaction other(&desc_other);
+
+    tx.begin();
+    tx.store(x, tx.load(x) + 1);
+
+    other.begin();
+    other.store(x, 100);
+    EXPECT_TRUE(other.commit());
+
+    EXPECT_FALSE(tx.commit());
+    EXPECT_EQ(readCommitted(x), 100);
+}
+
+// 读其他变量、只写一个变量：走通用验证
+TEST(OccAtomicUpdateTest, SingleWriteWithOtherReadsValidatesAll) {
+    STM::Var<int> a(1), b(2), out(0);
+
+    TransactionDescriptor desc;
+    Transaction tx(&desc);
+
+    tx.begin();
+    int sum = tx.load(a) + tx.load(b);
+    b.atomicUpdate([](const int& v) { return v + 1; });
+    tx.store(out, sum);
+    EXPECT_FALSE(tx.commit());
+
+    tx.begin();
+    tx.store(out, tx.load(a) + tx.load(b));
+    EXPECT_TRUE(tx.commit());
+    EXPECT_EQ(readCommitted(out), 4);
+}
+
+// ==========================================
+// 3. 并发：快路径与普通事务混用
+// ==========================================
+template<typename Policy>
+void mixedCounter() {
+    TMVar<int, Policy> counter(0);
+
+    const int NUM_THREADS = 4;
+    const int OPS_PER_THREAD = 1000;
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < NUM_THREADS; ++t) {
+        workers.emplace_back([&, t]() {
+            for (int i = 0; i < OPS_PER_THREAD; ++i) {
+                if ((i + t) % 2 == 0) {
+                    counter.atomicUpdate([](const int& v) { return v + 1; });
+                }
+                else {
+                    STM::atomically<Policy>([&](BasicTransaction<Policy>& tx) {
+                        tx.store(counter, tx.load(counter) + 1);
+                    });
+                }
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+
+    EXPECT_EQ(readCommitted(counter), NUM_THREADS * OPS_PER_THREAD);
+}
+
+TEST(OccAtomicUpdateTest, ConcurrentMixedWithTransactions) {
+    mixedCounter<DefaultPolicy>();
+}
+
+TEST(OccAtomicUpdateTest, ConcurrentMixedWithEagerTransactions) {
+    mixedCounter<EagerPolicy>();
+}
@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "OccSTM/STM.hpp"
+#include "OccSTM/Coroutine.hpp"
+
+using namespace STM::Occ;
+
+namespace {
+
+CoTask<int> addOne(TxExecutor& exec, STM::Var<int>& x) {
+    co_return co_await co_atomically(exec, [&](Transaction& tx) {
+        int v = tx.load(x) + 1;
+        tx.store(x, v);
+        return v;
+    });
+}
+
+CoTask<int> addTwice(TxExecutor& exec, STM::Var<int>& x) {
+    co_await addOne(exec, x);
+    co_return co_await addOne(exec, x);
+}
+
+// 等到 x 非零后取走
+CoTask<int> take(TxExecutor& exec, STM::Var<int>& x, std::atomic<int>& attempts) {
+    co_return co_await co_atomically(exec, [&](Transaction& tx) {
+        attempts.fetch_add(1);
+        int v = tx.load(x);
+        if (v == 0) tx.retry();
+        tx.store(x, 0);
+        return v;
+    });
+}
+
+CoTask<> fail(TxExecutor& exec, STM::Var<int>& x) {
+    co_await co_atomically(exec, [&](Transaction& tx) {
+        tx.store(x, 2);
+        throw std::runtime_error("boom");
+    });
+}
+
+}
+
+TEST(OccCoroutineTest, ReturnsCommittedResult) {
+    STM::Var<int> x(41);
+    TxExecutor exec(2);
+
+    EXPECT_EQ(addOne(exec, x).get(), 42);
+    EXPECT_EQ(x.unsafeLoad(), 42);
+}
+
+TEST(OccCoroutineTest, AwaitsNestedTasks) {
+    STM::Var<int> x(0);
+    TxExecutor exec(1);
+
+    EXPECT_EQ(addTwice(exec, x).get(), 2);
+}
+
+TEST(OccCoroutineTest, ExceptionsPropagateAndRollBack) {
+    STM::Var<int> x(1);
+    TxExecutor exec(1);
+
+    EXPECT_THROW(fail(exec, x).get(), std::runtime_error);
+    EXPECT_EQ(x.unsafeLoad(), 1);
+}
+
+// retry 挂起协程而不是自旋：写入之前事务体只执行寥寥几次
+TEST(OccCoroutineTest, RetryWaitsForCommit) {
+    STM::Var<int> x(0);
+    std::atomic<int> attempts{0};
+    TxExecutor exec(1);
+
+    auto result = std::async(std::launch::async, [&]() { return take(exec, x, attempts).get(); });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(result.wait_for(std::chrono::milliseconds(0)), std::future_status::timeout);
+    EXPECT_LE(attempts.load(), 2);
+
+    STM::atomically([&](Transaction& tx) { tx.store(x, 7); });
+
+    EXPECT_EQ(result.get(), 7);
+    EXPECT_EQ(x.unsafeLoad(), 0);
+    EXPECT_LE(attempts.load(), 3);
+}
+
+// 非事务的提交路径同样会唤醒等待者
+TEST(OccCoroutineTest, RetryWakesOnAtomicUpdate) {
+    STM::Var<int> x(0);
+    std::atomic<int> attempts{0};
+    TxExecutor exec(1);
+
+    auto result = std::async(std::launch::async, [&]() { return take(exec, x, attempts).get(); });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    x.atomicUpdate([](const int&) { return 5; });
+
+    EXPECT_EQ(result.get(), 5);
+}
+
+// 一个生产者与大量消费者协程通过同一个变量交接，等待中的协程数远多于工作线程
+TEST(OccCoroutineTest, ManyWaitersHandOff) {
+    STM::Var<int> slot(0);
+    STM::Var<long> consumed(0);
+    const int kItems = 64;
+
+    {
+        TxExecutor exec(2);
+        std::atomic<int> attempts{0};
+
+        std::vector<std::thread> threads;
+        for (int i = 0; i < kItems; ++i) {
+            threads.emplace_back([&]() {
+                int v = take(exec, slot, attempts).get();
+                STM::atomically([&](Transaction& tx) { tx.store(consumed, tx.load(consumed) + v); });
+            });
+        }
+
+        for (int i = 1; i <= kItems; ++i) {
+            // 槽空了才放下一个
+            while (true) {
+                bool put = STM::atomically([&](Transaction& tx) {
+                    if (tx.load(slot) != 0) return false;
+                    tx.store(slot, i);
+                    return true;
+                });
+                if (put) break;
+                std::this_thread::yield();
+            }
+        }
+
+        for (auto& t : threads) t.join();
+    }
+
+    EXPECT_EQ(consumed.unsafeLoad(), static_cast<long>(kItems) * (kItems + 1) / 2);
+    EXPECT_EQ(slot.unsafeLoad(), 0);
+}
+
+// 冲突后重新投递，计数精确
+TEST(OccCoroutineTest, ConcurrentIncrements) {
+    STM::Var<int> x(0);
+    const int kTasks = 100;
+    {
+        TxExecutor exec(3);
+        std::vector<std::future<int>> results;
+        for (int i = 0; i < kTasks; ++i) {
+            results.push_back(std::async(std::launch::async, [&]() { return addOne(exec, x).get(); }));
+        }
+        for (auto& r : results) r.get();
+    }
+    EXPECT_EQ(x.unsafeLoad(), kTasks);
+}
@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include "OccSTM/STM.hpp"
+
+using namespace STM::Occ;
+using namespace std::chrono_literals;
+
+// 1. onCommit / onAbort 只对注册它们的那次尝试生效
+TEST(OccHandlersTest, CommitHandlersRunOnceAfterCommit) {
+    STM::Var<int> x(0);
+    int commits = 0;
+    int aborts = 0;
+    int attempts = 0;
+
+    STM::atomically([&](Transaction& tx) {
+        tx.onCommit([&]() { commits++; });
+        tx.onAbort([&]() { aborts++; });
+        tx.store(x, 1);
+        if (++attempts < 3) throw RetryException();
+    });
+
+    EXPECT_EQ(attempts, 3);
+    EXPECT_EQ(commits, 1);
+    EXPECT_EQ(aborts, 2);
+    EXPECT_EQ(x.unsafeLoad(), 1);
+}
+
+TEST(OccHandlersTest, AbortHandlersRunWhenBodyThrows) {
+    STM::Var<int> x(0);
+    std::string log;
+
+    EXPECT_THROW(STM::atomically([&](Transaction& tx) {
+        tx.onAbort([&]() { log += "a"; });
+        tx.onAbort([&]() { log += "b"; });
+        tx.onCommit([&]() { log += "c"; });
+        tx.store(x, 1);
+        throw std::runtime_error("boom");
+    }), std::runtime_error);
+
+    EXPECT_EQ(log, "ab");
+    EXPECT_EQ(x.unsafeLoad(), 0);
+}
+
+TEST(OccHandlersTest, EagerPolicyRunsHandlers) {
+    STM::Occ::TMVar<int, STM::Occ::EagerPolicy> x(0);
+    int commits = 0;
+    int aborts = 0;
+    int attempts = 0;
+
+    STM::atomically<STM::Occ::EagerPolicy>([&](BasicTransaction<STM::Occ::EagerPolicy>& tx) {
+        tx.onCommit([&]() { commits++; });
+        tx.onAbort([&]() { aborts++; });
+        tx.store(x, attempts);
+        if (++attempts < 2) throw RetryException();
+    });
+
+    EXPECT_EQ(commits, 1);
+    EXPECT_EQ(aborts, 1);
+    EXPECT_EQ(x.unsafeLoad(), 1);
+}
+
+// onCommit 回调抛出：异常在提交之后传播，不中止、不重做，也不执行 onAbort
+TEST(OccHandlersTest, ThrowingCommitHandlerKeepsCommit) {
+    STM::Var<int> x(0);
+    std::string log;
+    int attempts = 0;
+
+    EXPECT_THROW(STM::atomically([&](Transaction& tx) {
+        ++attempts;
+        tx.onAbort([&]() { log += "a"; });
+        tx.onCommit([&]() { log += "c"; throw std::runtime_error("handler"); });
+        tx.onCommit([&]() { log += "d"; });
+        tx.store(x, tx.load(x) + 1);
+    }), std::runtime_error);
+
+    EXPECT_EQ(attempts, 1);
+    EXPECT_EQ(log, "c");
+    EXPECT_EQ(x.unsafeLoad(), 1);
+
+    EXPECT_THROW(STM::tryAtomically(STM::TxDeadline::after(1s), [&](Transaction& tx) {
+        tx.onAbort([&]() { log += "a"; });
+        tx.onCommit([&]() { throw std::runtime_error("handler"); });
+        tx.store(x, tx.load(x) + 1);
+    }), std::runtime_error);
+
+    EXPECT_EQ(log, "c");
+    EXPECT_EQ(x.unsafeLoad(), 2);
+}
+
+// 2. tryAtomically
+TEST(OccDeadlineTest, CommitsWithinDeadline) {
+    STM::Var<int> x(41);
+
+    auto r = STM::tryAtomically(STM::TxDeadline::after(1s), [&](Transaction& tx) {
+        tx.store(x, tx.load(x) + 1);
+        return tx.load(x);
+    });
+
+    ASSERT_TRUE(r);
+    EXPECT_EQ(r.outcome, STM::TxOutcome::Committed);
+    EXPECT_EQ(*r.value, 42);
+}
+
+TEST(OccDeadlineTest, TimesOutInsteadOfRetryingForever) {
+    STM::Var<int> ready(0);
+    int aborts = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    auto r = STM::tryAtomically(STM::TxDeadline::after(20ms), [&](Transaction& tx) {
+        tx.onAbort([&]() { aborts++; });
+        if (tx.load(ready) == 0) tx.retry();
+        return 1;
+    });
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_FALSE(r);
+    EXPECT_EQ(r.outcome, STM::TxOutcome::TimedOut);
+    EXPECT_FALSE(r.value.has_value());
+    EXPECT_GE(aborts, 1);
+    EXPECT_GE(elapsed, 20ms);
+    EXPECT_LT(elapsed, 2s);
+}
+
+TEST(OccDeadlineTest, CancelledTokenSkipsTheBody) {
+    STM::Var<int> x(0);
+    STM::CancellationToken token;
+    token.cancel();
+
+    bool ran = false;
+    auto r = STM::tryAtomically(STM::TxDeadline().cancelledBy(token), [&](Transaction& tx) {
+        ran = true;
+        tx.store(x, 1);
+    });
+
+    EXPECT_EQ(r.outcome, STM::TxOutcome::Cancelled);
+    EXPECT_FALSE(ran);
+    EXPECT_EQ(x.unsafeLoad(), 0);
+}
+
+TEST(OccDeadlineTest, CancelFromAnotherThread) {
+    STM::Var<int> ready(0);
+    STM::CancellationToken token;
+
+    std::thread canceller([token]() mutable {
+        std::this_thread::sleep_for(10ms);
+        token.cancel();
+    });
+
+    auto r = STM::tryAtomically(STM::TxDeadline().cancelledBy(token), [&](Transaction& tx) {
+        if (tx.load(ready) == 0) tx.retry();
+    });
+    canceller.join();
+
+    EXPECT_EQ(r.outcome, STM::TxOutcome::Cancelled);
+}
+
+TEST(OccDeadlineTest, ExceptionsStillPropagate) {
+    STM::Var<int> x(0);
+
+    EXPECT_THROW(STM::tryAtomically(STM::TxDeadline::after(1s), [&](Transaction& tx) {
+        tx.store(x, 1);
+        throw std::runtime_error("boom");
+    }), std::runtime_error);
+    EXPECT_EQ(x.unsafeLoad(), 0);
+}
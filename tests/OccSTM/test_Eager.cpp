@@ -0,0 +1,318 @@
+#include <gtest/gtest.h>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "OccSTM/STM.hpp"
+
+using namespace STM::Occ;
+
+namespace {
+
+using EagerTx = BasicTransaction<EagerPolicy>;
+using EagerDesc = BasicTransactionDescriptor<EagerPolicy>;
+
+template<typename T>
+using EagerVar = TMVar<T, EagerPolicy>;
+
+// 在每次读锁字前后执行测试钩子的锁表，用来确定性地插入并发写者的动作
+struct HookedLockTable {
+    using Table = BasicVersionedLockTable<10>;
+
+    // 参数：true 为读锁字之前，false 为之后；钩子执行期间的 load 不再触发
+    static inline std::function<void(bool)> hook;
+
+    static HookedLockTable& instance() {
+        static HookedLockTable table;
+        return table;
+    }
+
+    size_t getStripeIndex(const void* addr) const { return Table::instance().getStripeIndex(addr); }
+
+    uint64_t load(size_t index) const {
+        std::function<void(bool)> fn = std::move(hook);
+        if (fn) fn(true);
+        uint64_t word = Table::instance().load(index);
+        if (fn) fn(false);
+        hook = std::move(fn);
+        return word;
+    }
+
+    bool tryLock(size_t index, uint64_t expected) { return Table::instance().tryLock(index, expected); }
+    void unlock(size_t index, uint64_t version) { Table::instance().unlock(index, version); }
+
+    static bool isLocked(uint64_t word) { return Table::isLocked(word); }
+    static uint64_t versionOf(uint64_t word) { return Table::versionOf(word); }
+};
+
+struct HookedEagerPolicy : EagerPolicy {
+    using LockTable = HookedLockTable;
+};
+
+}
+
+// ==========================================
+// 1. 单线程语义
+// ==========================================
+
+// 写入原地生效，不会产生新版本节点
+TEST(OccEagerTest, StoreWritesInPlace) {
+    EagerVar<int> var(1);
+    auto* head = var.loadHead();
+
+    EagerDesc desc;
+    EagerTx tx(&desc);
+
+    tx.begin();
+    tx.store(var, 2);
+    EXPECT_EQ(head->payload, 2);
+    EXPECT_EQ(tx.load(var), 2);
+    tx.store(var, 3);
+    EXPECT_EQ(tx.load(var), 3);
+    EXPECT_TRUE(tx.commit());
+
+    EXPECT_EQ(var.loadHead(), head);
+    EXPECT_EQ(head->payload, 3);
+    EXPECT_TRUE(desc.undoLog().empty());
+}
+
+// 没有持锁的 begin / abort / 只读提交不推进全局时钟
+TEST(OccEagerTest, ReadOnlyDoesNotTickClock) {
+    EagerVar<int> var(1);
+    EagerDesc desc;
+    EagerTx tx(&desc);
+
+    uint64_t before = EagerPolicy::Clock::now();
+    tx.begin();
+    EXPECT_EQ(tx.load(var), 1);
+    tx.abort();
+    tx.begin();
+    EXPECT_EQ(tx.load(var), 1);
+    EXPECT_TRUE(tx.commit());
+    EXPECT_EQ(EagerPolicy::Clock::now(), before);
+}
+
+// emplace 同样原地生效
+TEST(OccEagerTest, EmplaceWritesInPlace) {
+    struct Point { int x; int y; };
+    EagerVar<Point> var(Point{1, 2});
+    auto* head = var.loadHead();
+
+    EagerDesc desc;
+    EagerTx tx(&desc);
+
+    tx.begin();
+    tx.emplace(var, Point{3, 4});
+    EXPECT_EQ(head->payload.y, 4);
+    EXPECT_TRUE(tx.commit());
+    EXPECT_EQ(var.loadHead(), head);
+}
+
+// 中止时按 Undo 日志恢复首次写入前的值，并释放条带锁
+TEST(OccEagerTest, AbortRestoresOldValue) {
+    EagerVar<int> x(10);
+    EagerVar<int> y(20);
+
+    EagerDesc desc;
+    EagerTx tx(&desc);
+
+    tx.begin();
+    tx.store(x, 11);
+    tx.store(x, 12);
+    tx.store(y, 21);
+    tx.abort();
+
+    EXPECT_EQ(x.loadHead()->payload, 10);
+    EXPECT_EQ(y.loadHead()->payload, 20);
+
+    auto& table = EagerPolicy::LockTable::instance();
+    EXPECT_FALSE(EagerPolicy::LockTable::isLocked(table.load(table.getStripeIndex(&x))));
+    EXPECT_FALSE(EagerPolicy::LockTable::isLocked(table.load(table.getStripeIndex(&y))));
+}
+
+// 多个变量反复写入：每个变量只记录一次旧值，中止时全部恢复；描述符复用后重新记录
+TEST(OccEagerTest, UndoLogRecordsEachVariableOnce) {
+    struct Point { int x; int y; };
+    std::vector<std::unique_ptr<EagerVar<Point>>> vars;
+    for (int i = 0; i < 100; ++i) vars.push_back(std::make_unique<EagerVar<Point>>(Point{i, -i}));
+
+    EagerDesc desc;
+    EagerTx tx(&desc);
+
+    tx.begin();
+    for (int round = 0; round < 3; ++round) {
+        for (auto& var : vars) tx.store(*var, Point{round, round});
+    }
+    EXPECT_EQ(desc.undoLog().size(), vars.size());
+    tx.abort();
+
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(vars[i]->loadHead()->payload.x, i);
+        EXPECT_EQ(vars[i]->loadHead()->payload.y, -i);
+    }
+
+    tx.begin();
+    tx.store(*vars[7], Point{70, 71});
+    tx.store(*vars[7], Point{72, 73});
+    EXPECT_EQ(desc.undoLog().size(), 1u);
+    EXPECT_TRUE(tx.commit());
+    EXPECT_EQ(vars[7]->loadHead()->payload.y, 73);
+}
+
+// 读者在两次读锁字之间拷贝到写者未提交的值，随后写者中止：中止必须换新版本，读者重试
+TEST(OccEagerTest, AbortInvalidatesConcurrentOptimisticRead) {
+    TMVar<int, HookedEagerPolicy> x(0);
+
+    BasicTransactionDescriptor<HookedEagerPolicy> desc_reader, desc_writer;
+    BasicTransaction<HookedEagerPolicy> reader(&desc_reader);
+    BasicTransaction<HookedEagerPolicy> writer(&desc_writer);
+
+    reader.begin();
+    writer.begin();
+
+    int loads = 0;
+    HookedLockTable::hook = [&](bool before) {
+        if (!before && loads == 0) writer.store(x, 42);  // 读者看到未上锁的锁字之后，写者原地写入
+        if (before && loads == 1) writer.abort();        // 读者拷贝之后、复查锁字之前，写者中止
+        if (!before) ++loads;
+    };
+
+    EXPECT_THROW(reader.load(x), RetryException);
+    HookedLockTable::hook = nullptr;
+    EXPECT_EQ(loads, 2);
+    reader.abort();
+
+    EXPECT_EQ(x.loadHead()->payload, 0);
+}
+
+// 写者持锁期间，其他事务的读取与写入都要重试
+TEST(OccEagerTest, LockedStripeForcesRetry) {
+    EagerVar<int> x(1);
+
+    EagerDesc desc_writer, desc_other;
+    EagerTx writer(&desc_writer);
+    EagerTx other(&desc_other);
+
+    writer.begin();
+    writer.store(x, 2);
+
+    other.begin();
+    EXPECT_THROW(other.load(x), RetryException);
+    other.abort();
+
+    other.begin();
+    EXPECT_THROW(other.store(x, 3), RetryException);
+    other.abort();
+
+    EXPECT_TRUE(writer.commit());
+
+    other.begin();
+    EXPECT_EQ(other.load(x), 2);
+    EXPECT_TRUE(other.commit());
+}
+
+// 读过的条带被别人提交：提交时版本验证失败，写入被撤销
+TEST(OccEagerTest, StaleReadFailsValidation) {
+    EagerVar<int> x(1);
+    EagerVar<int> y(1);
+
+    EagerDesc desc, desc_other;
+    EagerTx tx(&desc);
+    EagerTx other(&desc_other);
+
+    tx.begin();
+    EXPECT_EQ(tx.load(x), 1);
+
+    other.begin();
+    other.store(x, 5);
+    EXPECT_TRUE(other.commit());
+
+    tx.store(y, 2);
+    EXPECT_FALSE(tx.commit());
+    EXPECT_EQ(y.loadHead()->payload, 1);
+}
+
+// 用户异常经 atomically 回滚
+TEST(OccEagerTest, ExceptionRollsBack) {
+    EagerVar<int> var(7);
+
+    EXPECT_THROW(
+        STM::atomically<EagerPolicy>([&](EagerTx& tx) {
+            tx.store(var, 8);
+            throw std::runtime_error("boom");
+        }),
+        std::runtime_error);
+
+    int val = STM::atomically<EagerPolicy>([&](EagerTx& tx) { return tx.load(var); });
+    EXPECT_EQ(val, 7);
+}
+
+// ==========================================
+// 2. 并发测试
+// ==========================================
+TEST(OccEagerTest, ConcurrentCounter) {
+    EagerVar<int> counter(0);
+
+    const int NUM_THREADS = 4;
+    const int INC_PER_THREAD = 1000;
+
+    std::vector<std::thread> workers;
+    for (int i = 0; i < NUM_THREADS; ++i) {
+        workers.emplace_back([&]() {
+            for (int j = 0; j < INC_PER_THREAD; ++j) {
+                STM::atomically<EagerPolicy>([&](EagerTx& tx) {
+                    tx.store(counter, tx.load(counter) + 1);
+                });
+            }
+        });
+    }
+    for (auto& t : workers) t.join();
+
+    int final_val = STM::atomically<EagerPolicy>([&](EagerTx& tx) { return tx.load(counter); });
+    EXPECT_EQ(final_val, NUM_THREADS * INC_PER_THREAD);
+}
+
+TEST(OccEagerTest, ConcurrentTransfersPreserveTotal) {
+    const int NUM_ACCOUNTS = 16;
+    const int NUM_THREADS = 4;
+    const int OPS_PER_THREAD = 500;
+
+    std::vector<EagerVar<int>*> accounts;
+    for (int i = 0; i < NUM_ACCOUNTS; ++i) accounts.push_back(new EagerVar<int>(100));
+
+    auto sumAll = [&]() {
+        return STM::atomically<EagerPolicy>([&](EagerTx& tx) {
+            int sum = 0;
+            for (auto* acc : accounts) sum += tx.load(*acc);
+            return sum;
+        });
+    };
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < NUM_THREADS; ++t) {
+        workers.emplace_back([&, t]() {
+            for (int i = 0; i < OPS_PER_THREAD; ++i) {
+                int from = (t * 7 + i) % NUM_ACCOUNTS;
+                int to = (t * 13 + i * 3 + 1) % NUM_ACCOUNTS;
+                if (from == to) continue;
+
+                STM::atomically<EagerPolicy>([&](EagerTx& tx) {
+                    int a = tx.load(*accounts[from]);
+                    int b = tx.load(*accounts[to]);
+                    tx.store(*accounts[from], a - 1);
+                    tx.store(*accounts[to], b + 1);
+                });
+
+                if (i % 50 == 0) {
+                    EXPECT_EQ(sumAll(), NUM_ACCOUNTS * 100);
+                }
+            }
+        });
+    }
+    for (auto& t : workers) t.join();
+
+    EXPECT_EQ(sumAll(), NUM_ACCOUNTS * 100);
+
+    for (auto* acc : accounts) delete acc;
+}
@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "OccSTM/STM.hpp"
+
+using namespace STM::Occ;
+
+namespace {
+
+// 按 key 升序的单链表，头部是 key 为 INT_MIN 的哨兵
+struct ListNode {
+    int key;
+    STM::Var<ListNode*> next;
+
+    explicit ListNode(int k, ListNode* n = nullptr) : key(k), next(n) {}
+};
+
+// 弹性遍历：只有 pred->next 必须在提交时仍然指向 curr
+void elasticInsert(Transaction& tx, ListNode* head, ListNode* node) {
+    tx.elastic(2);
+
+    ListNode* pred = head;
+    ListNode* curr = tx.load(pred->next);
+    while (curr != nullptr && curr->key < node->key) {
+        pred = curr;
+        curr = tx.load(curr->next);
+    }
+
+    tx.store(node->next, curr);
+    tx.store(pred->next, node);
+}
+
+}
+
+// ==========================================
+// 1. 提前释放
+// ==========================================
+TEST(OccElasticTest, ReleasedReadIsNotValidated) {
+    STM::Var<int> x(1), y(0);
+
+    TransactionDescriptor desc, desc_other;
+    Transaction tx(&desc);
+    Transaction other(&desc_other);
+
+    tx.begin();
+    EXPECT_EQ(tx.load(x), 1);
+    tx.release(x);
+
+    other.begin();
+    other.store(x, 2);
+    EXPECT_TRUE(other.commit());
+
+    tx.store(y, 1);
+    EXPECT_TRUE(tx.commit());
+}
+
+TEST(OccElasticTest, UnreleasedReadStillConflicts) {
+    STM::Var<int> x(1), y(0);
+
+    TransactionDescriptor desc, desc_other;
+    Transaction tx(&desc);
+    Transaction other(&desc_other);
+
+    tx.begin();
+    tx.load(x);
+
+    other.begin();
+    other.store(x, 2);
+    EXPECT_TRUE(other.commit());
+
+    tx.store(y, 1);
+    EXPECT_FALSE(tx.commit());
+}
+
+// ==========================================
+// 2. 弹性窗口
+// ==========================================
+
+// 路径前段被别人修改：不在窗口内，提交成功；窗口内的被修改则中止
+TEST(OccElasticTest, OnlyWindowIsValidated) {
+    std::vector<std::unique_ptr<STM::Var<int>>> path;
+    for (int i = 0; i < 8; ++i) path.push_back(std::make_unique<STM::Var<int>>(i));
+    STM::Var<int> target(0);
+
+    TransactionDescriptor desc, desc_other;
+    Transaction tx(&desc);
+    Transaction other(&desc_other);
+
+    auto traverse = [&]() {
+        tx.begin();
+        tx.elastic(2);
+        for (auto& var : path) tx.load(*var);
+        EXPECT_EQ(desc.readSet().size(), 2u);
+    };
+
+    auto bump = [&](STM::Var<int>& var) {
+        other.begin();
+        other.store(var, other.load(var) + 100);
+        EXPECT_TRUE(other.commit());
+    };
+
+    traverse();
+    bump(*path[0]);
+    tx.store(target, 1);
+    EXPECT_TRUE(tx.commit());
+
+    traverse();
+    bump(*path[7]);
+    tx.store(target, 2);
+    EXPECT_FALSE(tx.commit());
+}
+
+// 首次写入之后的读取全部计入读集
+TEST(OccElasticTest, ReadsAfterFirstWriteAreKept) {
+    STM::Var<int> a(0), b(0), c(0), d(0);
+
+    TransactionDescriptor desc, desc_other;
+    Transaction tx(&desc);
+    Transaction other(&desc_other);
+
+    tx.begin();
+    tx.elastic(1);
+    tx.load(a);
+    tx.store(b, 1);
+    tx.load(c);
+    tx.load(d);
+    EXPECT_EQ(desc.readSet().size(), 3u);
+
+    other.begin();
+    other.store(c, 5);
+    EXPECT_TRUE(other.commit());
+
+    EXPECT_FALSE(tx.commit());
+}
+
+// ==========================================
+// 3. 并发有序链表插入
+// ==========================================
+TEST(OccElasticTest, ConcurrentSortedListInsert) {
+    const int NUM_THREADS = 4;
+    const int KEYS_PER_THREAD = 200;
+
+    ListNode head(-1);
+    std::vector<std::unique_ptr<ListNode>> nodes;
+    for (int i = 0; i < NUM_THREADS * KEYS_PER_THREAD; ++i) {
+        nodes.push_back(std::make_unique<ListNode>(i));
+    }
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < NUM_THREADS; ++t) {
+        workers.emplace_back([&, t]() {
+            // 交错的 key 让各线程插入同一区域
+            for (int i = 0; i < KEYS_PER_THREAD; ++i) {
+                ListNode* node = nodes[i * NUM_THREADS + t].get();
+                STM::atomically([&](Transaction& tx) { elasticInsert(tx, &head, node); });
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+
+    std::vector<int> keys = STM::atomically([&](Transaction& tx) {
+        std::vector<int> out;
+        for (ListNode* n = tx.load(head.next); n != nullptr; n = tx.load(n->next)) {
+            out.push_back(n->key);
+        }
+        return out;
+    });
+
+    ASSERT_EQ(keys.size(), nodes.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        EXPECT_EQ(keys[i], static_cast<int>(i));
+    }
+}
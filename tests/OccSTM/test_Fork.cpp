@@ -0,0 +1,185 @@
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "OccSTM/STM.hpp"
+
+using namespace STM::Occ;
+
+namespace {
+
+template<typename T>
+T readCommitted(STM::Var<T>& var) {
+    return STM::atomically([&](Transaction& tx) { return tx.load(var); });
+}
+
+}
+
+// ==========================================
+// 1. 单线程语义
+// ==========================================
+
+// 互不相交的子任务并行执行，join 后随父事务一起提交
+TEST(OccForkTest, IndependentChildrenAreMerged) {
+    STM::Var<int> a(1), b(2), c(3);
+
+    STM::atomically([&](Transaction& tx) {
+        tx.fork(
+            [&](Transaction& child) { child.store(a, child.load(a) + 10); },
+            [&](Transaction& child) { child.store(b, child.load(b) + 20); },
+            [&](Transaction& child) { child.store(c, child.load(c) + 30); });
+
+        // join 之后父事务能读到子事务的写入
+        EXPECT_EQ(tx.load(a), 11);
+    });
+
+    EXPECT_EQ(readCommitted(a), 11);
+    EXPECT_EQ(readCommitted(b), 22);
+    EXPECT_EQ(readCommitted(c), 33);
+}
+
+// 子事务能看到 fork 之前父事务的写入
+TEST(OccForkTest, ChildrenSeeParentWrites) {
+    STM::Var<int> x(0), y(0);
+
+    STM::atomically([&](Transaction& tx) {
+        tx.store(x, 5);
+        tx.fork([&](Transaction& child) { child.store(y, child.load(x) * 2); });
+    });
+
+    EXPECT_EQ(readCommitted(y), 10);
+}
+
+// 兄弟之间读写相交：回退为按参数顺序串行执行
+TEST(OccForkTest, SiblingConflictFallsBackToSerialOrder) {
+    STM::Var<int> x(1), y(0);
+
+    STM::atomically([&](Transaction& tx) {
+        tx.fork(
+            [&](Transaction& child) { child.store(x, child.load(x) + 1); },
+            [&](Transaction& child) { child.store(y, child.load(x) * 10); });
+    });
+
+    EXPECT_EQ(readCommitted(x), 2);
+    EXPECT_EQ(readCommitted(y), 20);
+}
+
+// 只写不读的重叠按参数顺序合并
+TEST(OccForkTest, BlindWritesMergeInOrder) {
+    STM::Var<int> x(0);
+
+    STM::atomically([&](Transaction& tx) {
+        tx.fork(
+            [&](Transaction& child) { child.store(x, 1); },
+            [&](Transaction& child) { child.store(x, 2); });
+    });
+
+    EXPECT_EQ(readCommitted(x), 2);
+}
+
+// 子事务的结束回调随父事务执行；串行重做时作废的执行只运行 onAbort
+TEST(OccForkTest, ChildHandlersFollowParent) {
+    STM::Var<int> a(0), b(0), x(1), y(0);
+    int commits = 0;
+    int aborts = 0;
+
+    STM::atomically([&](Transaction& tx) {
+        tx.fork(
+            [&](Transaction& child) { child.store(a, 1); child.onCommit([&]() { commits++; }); },
+            [&](Transaction& child) { child.store(b, 2); child.onAbort([&]() { aborts++; }); });
+        EXPECT_EQ(commits, 0);
+    });
+    EXPECT_EQ(commits, 1);
+    EXPECT_EQ(aborts, 0);
+
+    commits = 0;
+    STM::atomically([&](Transaction& tx) {
+        tx.fork(
+            [&](Transaction& child) {
+                child.store(x, child.load(x) + 1);
+                child.onCommit([&]() { commits++; });
+                child.onAbort([&]() { aborts++; });
+            },
+            [&](Transaction& child) { child.store(y, child.load(x) * 10); });
+    });
+
+    // 并行的一次作废 (onAbort 1 次)，串行重做的一次提交 (onCommit 1 次)
+    EXPECT_EQ(readCommitted(y), 20);
+    EXPECT_EQ(commits, 1);
+    EXPECT_EQ(aborts, 1);
+
+    // 子任务失败：回调交给父事务的中止
+    aborts = 0;
+    int attempts = 0;
+    STM::atomically([&](Transaction& tx) {
+        tx.fork([&](Transaction& child) {
+            child.onAbort([&]() { aborts++; });
+            if (attempts++ == 0) throw RetryException();
+        });
+    });
+    EXPECT_EQ(aborts, 1);
+}
+
+// 子任务抛出异常：整个事务回滚，异常传给调用者
+TEST(OccForkTest, ChildExceptionAbortsParent) {
+    STM::Var<int> x(0), y(0);
+
+    EXPECT_THROW(
+        STM::atomically([&](Transaction& tx) {
+            tx.store(x, 1);
+            tx.fork(
+                [&](Transaction& child) { child.store(y, 1); },
+                [&](Transaction&) { throw std::runtime_error("index build failed"); });
+        }),
+        std::runtime_error);
+
+    EXPECT_EQ(readCommitted(x), 0);
+    EXPECT_EQ(readCommitted(y), 0);
+}
+
+TEST(OccForkTest, NestedFork) {
+    STM::Var<int> a(0), b(0), c(0);
+
+    STM::atomically([&](Transaction& tx) {
+        tx.fork(
+            [&](Transaction& child) {
+                child.fork(
+                    [&](Transaction& grandchild) { grandchild.store(a, 1); },
+                    [&](Transaction& grandchild) { grandchild.store(b, 2); });
+            },
+            [&](Transaction& child) { child.store(c, 3); });
+    });
+
+    EXPECT_EQ(readCommitted(a), 1);
+    EXPECT_EQ(readCommitted(b), 2);
+    EXPECT_EQ(readCommitted(c), 3);
+}
+
+// ==========================================
+// 2. 并发测试
+// ==========================================
+
+// 多个线程的事务各自 fork，子任务更新共享计数器；冲突时整个父事务重试
+TEST(OccForkTest, ConcurrentForkingTransactions) {
+    STM::Var<int> left(0), right(0);
+
+    const int NUM_THREADS = 4;
+    const int OPS_PER_THREAD = 300;
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < NUM_THREADS; ++t) {
+        workers.emplace_back([&]() {
+            for (int i = 0; i < OPS_PER_THREAD; ++i) {
+                STM::atomically([&](Transaction& tx) {
+                    tx.fork(
+                        [&](Transaction& child) { child.store(left, child.load(left) + 1); },
+                        [&](Transaction& child) { child.store(right, child.load(right) + 1); });
+                });
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+
+    EXPECT_EQ(readCommitted(left), NUM_THREADS * OPS_PER_THREAD);
+    EXPECT_EQ(readCommitted(right), NUM_THREADS * OPS_PER_THREAD);
+}
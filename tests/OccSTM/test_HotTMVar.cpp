@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "OccSTM/STM.hpp"
+#include "OccSTM/HotTMVar.hpp"
+
+using namespace STM::Occ;
+
+namespace {
+
+template<typename T, typename Policy>
+T readCommitted(TMVar<T, Policy>& var) {
+    return STM::atomically<Policy>([&](BasicTransaction<Policy>& tx) { return tx.load(var); });
+}
+
+// 拷贝构造可按需抛异常的负载
+struct Fragile {
+    int v;
+    static inline bool armed = false;
+
+    Fragile(int x) : v(x) {}
+    Fragile(const Fragile& o) : v(o.v) {
+        if (armed) throw std::runtime_error("copy failed");
+    }
+    Fragile& operator=(const Fragile&) = default;
+};
+
+}
+
+// ==========================================
+// 1. 单线程语义
+// ==========================================
+TEST(OccHotTMVarTest, UpdateReturnsNewValue) {
+    HotTMVar<long> hot(10L);
+
+    EXPECT_EQ(hot.update([](const long& v) { return v * 3; }), 30);
+    EXPECT_EQ(readCommitted(hot), 30);
+}
+
+// 事务照常读写热点变量
+TEST(OccHotTMVarTest, TransactionsStillWork) {
+    HotTMVar<int> hot(1);
+
+    STM::atomically([&](Transaction& tx) {
+        tx.store(hot, tx.load(hot) + 1);
+    });
+    EXPECT_EQ(hot.update([](const int& v) { return v + 1; }), 3);
+}
+
+TEST(OccHotTMVarTest, ThrowingOperationIsSkipped) {
+    HotTMVar<int> hot(5);
+
+    EXPECT_THROW(hot.update([](const int&) -> int { throw std::runtime_error("reject"); }), std::runtime_error);
+    EXPECT_EQ(hot.update([](const int& v) { return v + 1; }), 6);
+}
+
+// 合并者持锁时拷贝失败：异常交给调用者，变量不变，条带锁被释放
+TEST(OccHotTMVarTest, CombinerCopyFailureReleasesStripe) {
+    HotTMVar<Fragile> hot(Fragile{1});
+
+    Fragile::armed = true;
+    EXPECT_THROW(hot.update([](const Fragile& f) { return Fragile{f.v + 1}; }), std::runtime_error);
+    Fragile::armed = false;
+
+    EXPECT_EQ(hot.loadHead()->payload.v, 1);
+    EXPECT_EQ(hot.update([](const Fragile& f) { return Fragile{f.v + 1}; }).v, 2);
+}
+
+// 读过热点变量的事务在合并提交后验证失败
+TEST(OccHotTMVarTest, CombinedCommitInvalidatesReaders) {
+    HotTMVar<int> hot(0);
+    STM::Var<int> out(0);
+
+    TransactionDescriptor desc;
+    Transaction tx(&desc);
+
+    tx.begin();
+    int seen = tx.load(hot);
+    hot.update([](const int& v) { return v + 1; });
+    tx.store(out, seen);
+    EXPECT_FALSE(tx.commit());
+}
+
+// ==========================================
+// 2. 并发：合并更新与普通事务混用
+// ==========================================
+template<typename Policy>
+void concurrentHotCounter() {
+    HotTMVar<long, Policy> hot(0L);
+
+    const int NUM_THREADS = 4;
+    const int OPS_PER_THREAD = 2000;
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < NUM_THREADS; ++t) {
+        workers.emplace_back([&, t]() {
+            for (int i = 0; i < OPS_PER_THREAD; ++i) {
+                if (t == 0 && i % 4 == 0) {
+                    STM::atomically<Policy>([&](BasicTransaction<Policy>& tx) {
+                        tx.store(hot, tx.load(hot) + 1);
+                    });
+                }
+                else {
+                    hot.update([](const long& v) { return v + 1; });
+                }
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+
+    EXPECT_EQ(readCommitted(hot), NUM_THREADS * OPS_PER_THREAD);
+}
+
+TEST(OccHotTMVarTest, ConcurrentUpdatesAreExact) {
+    concurrentHotCounter<DefaultPolicy>();
+}
+
+TEST(OccHotTMVarTest, ConcurrentUpdatesAreExactEager) {
+    concurrentHotCounter<EagerPolicy>();
+}
@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include "OccSTM/STM.hpp"
+#include "WwSTM/TxContext.hpp"
+#include "WwSTM/TMVar.hpp"
+
+using namespace STM::Occ;
+
+TEST(OccLayoutTest, PaddedVarOwnsCacheLine) {
+    static_assert(sizeof(STM::LaidOutVar<long, STM::PackedLayout>) == sizeof(STM::Var<long>));
+    static_assert(sizeof(STM::LaidOutVar<long, STM::CacheLineLayout>) == kCacheLineSize);
+    static_assert(alignof(STM::LaidOutVar<long, STM::CacheLineLayout>) == kCacheLineSize);
+
+    std::vector<STM::ThreadHeapPtr<STM::LaidOutVar<long, STM::CacheLineLayout>>> vars;
+    for (int i = 0; i < 16; ++i) vars.push_back(STM::makeVar<long>(static_cast<long>(i)));
+
+    for (size_t i = 0; i < vars.size(); ++i) {
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(vars[i].get()) % kCacheLineSize, 0u);
+        for (size_t j = 0; j < i; ++j) {
+            auto a = reinterpret_cast<uintptr_t>(vars[i].get()) / kCacheLineSize;
+            auto b = reinterpret_cast<uintptr_t>(vars[j].get()) / kCacheLineSize;
+            EXPECT_NE(a, b);
+        }
+    }
+}
+
+// 两种布局的变量都能直接用于事务
+TEST(OccLayoutTest, LaidOutVarsWorkInTransactions) {
+    auto hot = STM::makeVar<long>(0L);
+    auto cold = STM::makeVar<long, STM::PackedLayout>(10L);
+
+    const int kThreads = 4;
+    const int kOps = 500;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < kThreads; ++t) {
+        workers.emplace_back([&]() {
+            for (int i = 0; i < kOps; ++i) {
+                STM::atomically([&](Transaction& tx) {
+                    tx.store(*hot, tx.load(*hot) + tx.load(*cold) / 10);
+                });
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+
+    EXPECT_EQ(hot->unsafeLoad(), kThreads * kOps);
+}
+
+TEST(OccLayoutTest, WwPaddedVar) {
+    static_assert(sizeof(STM::Ww::LaidOutVar<int, STM::CacheLineLayout>) == kCacheLineSize);
+
+    auto var = STM::Ww::makeVar<int>(1);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(var.get()) % kCacheLineSize, 0u);
+
+    STM::Ww::TxContext tx;
+    tx.write(*var, tx.read(*var) + 1);
+    ASSERT_TRUE(tx.commit());
+
+    STM::Ww::TxContext check;
+    EXPECT_EQ(check.read(*var), 2);
+    check.commit();
+}
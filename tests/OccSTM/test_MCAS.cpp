@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "OccSTM/STM.hpp"
+#include "OccSTM/MCAS.hpp"
+
+using namespace STM::Occ;
+
+namespace {
+
+template<typename T, typename Policy>
+T readCommitted(TMVar<T, Policy>& var) {
+    return STM::atomically<Policy>([&](BasicTransaction<Policy>& tx) { return tx.load(var); });
+}
+
+struct ListNode {
+    int key;
+    STM::Var<ListNode*> next;
+
+    explicit ListNode(int k) : key(k), next(nullptr) {}
+};
+
+// 拷贝构造可按需抛异常的负载
+struct Fragile {
+    int v;
+    static inline bool armed = false;
+
+    Fragile(int x) : v(x) {}
+    Fragile(const Fragile& o) : v(o.v) {
+        if (armed && v == 30) throw std::runtime_error("copy failed");
+    }
+    Fragile& operator=(const Fragile&) = default;
+    bool operator==(const Fragile& o) const { return v == o.v; }
+};
+
+}
+
+// ==========================================
+// 1. 基本语义
+// ==========================================
+TEST(OccMCASTest, AllMatchSwapsAll) {
+    STM::Var<int> a(1), b(2);
+    STM::Var<std::string> c("old");
+
+    EXPECT_TRUE(STM::mcas(STM::CasOp{&a, 1, 10}, STM::CasOp{&b, 2, 20}, STM::CasOp{&c, "old", "new"}));
+
+    EXPECT_EQ(readCommitted(a), 10);
+    EXPECT_EQ(readCommitted(b), 20);
+    EXPECT_EQ(readCommitted(c), "new");
+}
+
+TEST(OccMCASTest, AnyMismatchChangesNothing) {
+    STM::Var<int> a(1), b(2);
+
+    EXPECT_FALSE(STM::mcas(STM::CasOp{&a, 1, 10}, STM::CasOp{&b, 3, 30}));
+
+    EXPECT_EQ(readCommitted(a), 1);
+    EXPECT_EQ(readCommitted(b), 2);
+}
+
+// 新版本的拷贝构造抛异常：所有变量保持原值，条带锁全部释放
+TEST(OccMCASTest, ThrowingCopyLeavesAllUnchanged) {
+    STM::Var<int> a(1);
+    STM::Var<Fragile> b(Fragile{2});
+    STM::CasOp opA{&a, 1, 10};
+    STM::CasOp opB{&b, Fragile{2}, Fragile{30}};
+
+    Fragile::armed = true;
+    EXPECT_THROW(STM::mcas(opA, opB), std::runtime_error);
+    Fragile::armed = false;
+
+    EXPECT_EQ(readCommitted(a), 1);
+    EXPECT_EQ(readCommitted(b).v, 2);
+    // 锁若泄漏，这里会永远等下去
+    EXPECT_TRUE(STM::mcas(STM::CasOp{&a, 1, 10}, STM::CasOp{&b, Fragile{2}, Fragile{30}}));
+    EXPECT_EQ(readCommitted(a), 10);
+}
+
+// 链表拼接：两个指针一起改
+TEST(OccMCASTest, SplicesListNode) {
+    ListNode head(0), tail(9), mid(5);
+    STM::atomically([&](Transaction& tx) { tx.store(head.next, &tail); });
+
+    EXPECT_TRUE(STM::mcas(STM::CasOp{&head.next, &tail, &mid}, STM::CasOp{&mid.next, nullptr, &tail}));
+
+    EXPECT_EQ(readCommitted(head.next), &mid);
+    EXPECT_EQ(readCommitted(mid.next), &tail);
+}
+
+// 读过相关变量的事务在 mcas 之后不能提交
+TEST(OccMCASTest, InvalidatesConcurrentReaders) {
+    STM::Var<int> a(1), out(0);
+
+    TransactionDescriptor desc;
+    Transaction tx(&desc);
+
+    tx.begin();
+    int seen = tx.load(a);
+    EXPECT_TRUE(STM::mcas(STM::CasOp{&a, 1, 2}));
+    tx.store(out, seen);
+    EXPECT_FALSE(tx.commit());
+}
+
+// ==========================================
+// 2. 并发：a + b 恒定
+// ==========================================
+template<typename Policy>
+void concurrentTransfers() {
+    TMVar<int, Policy> a(1000), b(1000);
+
+    const int NUM_THREADS = 4;
+    const int OPS_PER_THREAD = 500;
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < NUM_THREADS; ++t) {
+        workers.emplace_back([&, t]() {
+            for (int i = 0; i < OPS_PER_THREAD; ++i) {
+                if (t == 0 && i % 10 == 0) {
+                    int sum = STM::atomically<Policy>([&](BasicTransaction<Policy>& tx) {
+                        return tx.load(a) + tx.load(b);
+                    });
+                    EXPECT_EQ(sum, 2000);
+                }
+
+                // 快照 + mcas，失败则重读
+                while (true) {
+                    auto [va, vb] = STM::atomically<Policy>([&](BasicTransaction<Policy>& tx) {
+                        return std::make_pair(tx.load(a), tx.load(b));
+                    });
+                    if (STM::mcas(STM::CasOp{&a, va, va - 1}, STM::CasOp{&b, vb, vb + 1})) break;
+                }
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+
+    EXPECT_EQ(readCommitted(a), 1000 - NUM_THREADS * OPS_PER_THREAD);
+    EXPECT_EQ(readCommitted(b), 1000 + NUM_THREADS * OPS_PER_THREAD);
+}
+
+TEST(OccMCASTest, ConcurrentTransfersKeepInvariant) {
+    concurrentTransfers<DefaultPolicy>();
+}
+
+TEST(OccMCASTest, ConcurrentTransfersKeepInvariantEager) {
+    concurrentTransfers<EagerPolicy>();
+}
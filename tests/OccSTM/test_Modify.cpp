@@ -0,0 +1,192 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <string>
+#include <thread>
+#include <vector>
+#include "OccSTM/STM.hpp"
+
+using namespace STM::Occ;
+
+namespace {
+
+// 约 1KB 的记录，只改其中的小字段
+struct Record {
+    long balance = 0;
+    int version = 0;
+    std::string owner;
+    std::array<char, 1000> blob{};
+};
+
+}
+
+TEST(OccModifyTest, PatchIsVisibleToOwnReads) {
+    STM::Var<Record> var(Record{10, 1, "alice"});
+
+    STM::atomically([&](Transaction& tx) {
+        tx.modify(var, &Record::balance, 20);
+        tx.modify(var, &Record::owner, std::string("bob"));
+
+        Record r = tx.load(var);
+        EXPECT_EQ(r.balance, 20);
+        EXPECT_EQ(r.owner, "bob");
+        EXPECT_EQ(r.version, 1);
+    });
+
+    const Record& r = var.unsafeLoad();
+    EXPECT_EQ(r.balance, 20);
+    EXPECT_EQ(r.owner, "bob");
+    EXPECT_EQ(r.version, 1);
+}
+
+// 先整体写入再改字段：直接改自己的新节点
+TEST(OccModifyTest, ModifyAfterStore) {
+    STM::Var<Record> var(Record{1, 1, "a"});
+
+    STM::atomically([&](Transaction& tx) {
+        tx.store(var, Record{5, 5, "b"});
+        tx.modify(var, &Record::version, 6);
+        EXPECT_EQ(tx.view(var).version, 6);
+    });
+
+    EXPECT_EQ(var.unsafeLoad().balance, 5);
+    EXPECT_EQ(var.unsafeLoad().version, 6);
+}
+
+// view 会把补丁物化成完整的值
+TEST(OccModifyTest, ViewMaterializesPatch) {
+    STM::Var<Record> var(Record{1, 1, "a"});
+
+    STM::atomically([&](Transaction& tx) {
+        tx.modify(var, &Record::balance, 2);
+        EXPECT_EQ(tx.view(var).balance, 2);
+        tx.modify(var, &Record::version, 3);
+        EXPECT_EQ(tx.load(var).version, 3);
+    });
+
+    EXPECT_EQ(var.unsafeLoad().balance, 2);
+    EXPECT_EQ(var.unsafeLoad().version, 3);
+}
+
+// 内联的字段补丁与闭包补丁按调用顺序应用，日志超出内联容量后搬到堆上
+TEST(OccModifyTest, InlineAndClosureOpsKeepOrder) {
+    STM::Var<Record> var(Record{0, 0, "a"});
+
+    STM::atomically([&](Transaction& tx) {
+        for (int i = 1; i <= 20; ++i) {
+            tx.modify(var, &Record::version, i);
+            if (i == 10) tx.patch(var, [](Record& r) { r.balance = r.version * 100; });
+        }
+        tx.modify(var, &Record::owner, std::string("z"));
+
+        Record r = tx.load(var);
+        EXPECT_EQ(r.version, 20);
+        EXPECT_EQ(r.balance, 1000);
+        EXPECT_EQ(r.owner, "z");
+    });
+
+    EXPECT_EQ(var.unsafeLoad().version, 20);
+    EXPECT_EQ(var.unsafeLoad().balance, 1000);
+    EXPECT_EQ(var.unsafeLoad().owner, "z");
+}
+
+// 锁外拷贝之后变量被别人提交：持锁时重新拷贝最新版本再应用补丁
+TEST(OccModifyTest, CommitterRecopiesWhenHeadMoved) {
+    STM::Var<Record> var(Record{1, 1, "a"});
+    auto* patch = new detail::FieldPatch<Record>();
+    patch->assign(&Record::balance, 7L);
+    TMVar<Record>::patchPreparer(&var, patch);
+
+    STM::atomically([&](Transaction& tx) { tx.modify(var, &Record::owner, std::string("b")); });
+
+    auto& table = DefaultPolicy::LockTable::instance();
+    size_t idx = table.getStripeIndex(&var);
+    table.lockByIndex(idx);
+    TMVar<Record>::patchCommitter(&var, patch, DefaultPolicy::Clock::tick());
+    table.unlockByIndex(idx);
+
+    EXPECT_EQ(var.unsafeLoad().balance, 7);
+    EXPECT_EQ(var.unsafeLoad().owner, "b");
+}
+
+TEST(OccModifyTest, AbortDiscardsPatch) {
+    STM::Var<Record> var(Record{1, 1, "a"});
+    TransactionDescriptor desc;
+    Transaction tx(&desc);
+
+    tx.begin();
+    tx.modify(var, &Record::balance, 100);
+    tx.abort();
+
+    EXPECT_EQ(var.unsafeLoad().balance, 1);
+}
+
+// 未读取的变量只做字段写入：补丁在提交时叠加到最新版本上，不会冲突
+TEST(OccModifyTest, BlindPatchesOnDifferentFieldsMerge) {
+    STM::Var<Record> var(Record{0, 0, "a"});
+    TransactionDescriptor desc_a, desc_b;
+    Transaction a(&desc_a);
+    Transaction b(&desc_b);
+
+    a.begin();
+    b.begin();
+    a.modify(var, &Record::balance, 7);
+    b.modify(var, &Record::version, 9);
+    EXPECT_TRUE(b.commit());
+    EXPECT_TRUE(a.commit());
+
+    EXPECT_EQ(var.unsafeLoad().balance, 7);
+    EXPECT_EQ(var.unsafeLoad().version, 9);
+}
+
+// 读过之后再改字段：按变量整体验证
+TEST(OccModifyTest, ReadThenModifyConflicts) {
+    STM::Var<Record> var(Record{0, 0, "a"});
+    TransactionDescriptor desc_a, desc_b;
+    Transaction a(&desc_a);
+    Transaction b(&desc_b);
+
+    a.begin();
+    long seen = a.view(var).balance;
+    a.modify(var, &Record::balance, seen + 1);
+
+    b.begin();
+    b.modify(var, &Record::version, 1);
+    EXPECT_TRUE(b.commit());
+
+    EXPECT_FALSE(a.commit());
+    EXPECT_EQ(var.unsafeLoad().balance, 0);
+}
+
+TEST(OccModifyTest, EagerModifyWritesInPlace) {
+    struct Point { int x; int y; };
+    STM::Var<Point, EagerPolicy> var(Point{1, 2});
+
+    STM::atomically<EagerPolicy>([&](BasicTransaction<EagerPolicy>& tx) {
+        tx.modify(var, &Point::y, 5);
+        EXPECT_EQ(tx.load(var).y, 5);
+    });
+
+    EXPECT_EQ(var.unsafeLoad().x, 1);
+    EXPECT_EQ(var.unsafeLoad().y, 5);
+}
+
+TEST(OccModifyTest, ConcurrentReadModifyWrite) {
+    STM::Var<Record> var(Record{0, 0, "a"});
+    const int kThreads = 4;
+    const int kOps = 500;
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < kThreads; ++t) {
+        workers.emplace_back([&]() {
+            for (int i = 0; i < kOps; ++i) {
+                STM::atomically([&](Transaction& tx) {
+                    const Record& r = tx.view(var);
+                    tx.modify(var, &Record::balance, r.balance + 1);
+                });
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+
+    EXPECT_EQ(var.unsafeLoad().balance, kThreads * kOps);
+}
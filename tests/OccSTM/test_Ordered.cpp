@@ -0,0 +1,181 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "OccSTM/Ordered.hpp"
+
+using namespace STM::Occ;
+
+namespace {
+
+// 不满足交换律的更新：任何乱序提交都会改变最终结果
+uint64_t mix(uint64_t acc, uint64_t seq) {
+    return acc * 1000003u + seq + 1;
+}
+
+}
+
+// ==========================================
+// 1. 单线程 / 两线程顺序语义
+// ==========================================
+
+// 序号靠后的事务先开始执行，也必须等前一个提交后再提交，且看到前一个的写入
+TEST(OccOrderedTest, LaterSequenceWaitsForEarlier) {
+    STM::Var<int> x(0);
+    OrderedDomain domain;
+
+    std::atomic<bool> second_started{false};
+    int seen_by_second = -1;
+
+    std::thread second([&]() {
+        seen_by_second = domain.atomically(1, [&](Transaction& tx) {
+            second_started.store(true);
+            int v = tx.load(x);
+            tx.store(x, v * 10);
+            return v;
+        });
+    });
+
+    while (!second_started.load()) std::this_thread::yield();
+    EXPECT_EQ(domain.nextSequence(), 0u);
+
+    domain.atomically(0, [&](Transaction& tx) {
+        tx.store(x, tx.load(x) + 7);
+    });
+
+    second.join();
+
+    EXPECT_EQ(seen_by_second, 7);
+    EXPECT_EQ(domain.nextSequence(), 2u);
+    int final_val = STM::atomically([&](Transaction& tx) { return tx.load(x); });
+    EXPECT_EQ(final_val, 70);
+}
+
+// 只读事务的返回值同样对应串行位置上的状态
+TEST(OccOrderedTest, ReadOnlyResultMatchesSerialPoint) {
+    STM::Var<int> x(1);
+    OrderedDomain domain(5);
+
+    std::atomic<bool> reader_started{false};
+    int observed = -1;
+
+    std::thread reader([&]() {
+        observed = domain.atomically(6, [&](Transaction& tx) {
+            reader_started.store(true);
+            return tx.load(x);
+        });
+    });
+
+    while (!reader_started.load()) std::this_thread::yield();
+
+    domain.atomically(5, [&](Transaction& tx) {
+        tx.store(x, 2);
+    });
+
+    reader.join();
+    EXPECT_EQ(observed, 2);
+}
+
+// 用户异常：重做确认后原样抛出，序号照常推进
+TEST(OccOrderedTest, ExceptionReleasesSequence) {
+    STM::Var<int> x(0);
+    OrderedDomain domain;
+
+    EXPECT_THROW(
+        domain.atomically(0, [&](Transaction& tx) {
+            tx.store(x, 1);
+            throw std::runtime_error("bad entry");
+        }),
+        std::runtime_error);
+
+    EXPECT_EQ(domain.nextSequence(), 1u);
+
+    domain.atomically(1, [&](Transaction& tx) {
+        tx.store(x, tx.load(x) + 2);
+    });
+
+    int final_val = STM::atomically([&](Transaction& tx) { return tx.load(x); });
+    EXPECT_EQ(final_val, 2);
+}
+
+// onCommit 回调抛出：事务已提交，推测执行的也不重做，序号照常推进
+TEST(OccOrderedTest, ThrowingCommitHandlerDoesNotReplay) {
+    STM::Var<int> x(0);
+    STM::Var<int> y(0);
+    OrderedDomain domain;
+    std::atomic<int> runs{0};
+
+    // 序号 1 在轮次之外开始，与序号 0 不冲突，轮到时直接提交，随后回调抛出
+    std::thread later([&] {
+        EXPECT_THROW(domain.atomically(1, [&](Transaction& tx) {
+            tx.onCommit([&] { runs++; throw std::runtime_error("handler"); });
+            tx.store(y, tx.load(y) + 10);
+        }), std::runtime_error);
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    domain.atomically(0, [&](Transaction& tx) { tx.store(x, 1); });
+    later.join();
+
+    EXPECT_EQ(runs.load(), 1);
+    EXPECT_EQ(domain.nextSequence(), 2u);
+    EXPECT_EQ(x.unsafeLoad(), 1);
+    EXPECT_EQ(y.unsafeLoad(), 10);
+}
+
+// ==========================================
+// 2. 并行回放
+// ==========================================
+
+// 多线程交错领取序号，结果必须与串行回放逐位相同
+TEST(OccOrderedTest, ParallelReplayMatchesSerial) {
+    const int NUM_THREADS = 4;
+    const uint64_t NUM_ENTRIES = 2000;
+    const int NUM_SLOTS = 8;
+
+    std::vector<STM::Var<uint64_t>*> slots;
+    for (int i = 0; i < NUM_SLOTS; ++i) slots.push_back(new STM::Var<uint64_t>(0));
+    STM::Var<uint64_t> chain(0);
+
+    // 每条日志只碰一个槽位 + 一条全局链：槽位之间可以并行推测，链必须按序
+    auto apply = [&](Transaction& tx, uint64_t seq) {
+        auto& slot = *slots[seq % NUM_SLOTS];
+        tx.store(slot, mix(tx.load(slot), seq));
+        if (seq % 16 == 0) {
+            tx.store(chain, mix(tx.load(chain), seq));
+        }
+    };
+
+    OrderedDomain domain;
+    std::atomic<uint64_t> ticket{0};
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < NUM_THREADS; ++t) {
+        workers.emplace_back([&]() {
+            for (uint64_t seq = ticket.fetch_add(1); seq < NUM_ENTRIES; seq = ticket.fetch_add(1)) {
+                domain.atomically(seq, [&](Transaction& tx) { apply(tx, seq); });
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+
+    // 串行参照
+    std::vector<uint64_t> expected_slots(NUM_SLOTS, 0);
+    uint64_t expected_chain = 0;
+    for (uint64_t seq = 0; seq < NUM_ENTRIES; ++seq) {
+        expected_slots[seq % NUM_SLOTS] = mix(expected_slots[seq % NUM_SLOTS], seq);
+        if (seq % 16 == 0) expected_chain = mix(expected_chain, seq);
+    }
+
+    EXPECT_EQ(domain.nextSequence(), NUM_ENTRIES);
+    STM::atomically([&](Transaction& tx) {
+        for (int i = 0; i < NUM_SLOTS; ++i) {
+            EXPECT_EQ(tx.load(*slots[i]), expected_slots[i]);
+        }
+        EXPECT_EQ(tx.load(chain), expected_chain);
+    });
+
+    for (auto* s : slots) delete s;
+}
@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include <type_traits>
+#include "OccSTM/STM.hpp"
+
+using namespace STM::Occ;
+
+namespace {
+
+// 独立时钟域的标签
+struct IsolatedClockTag {};
+
+// 浅历史 + 小锁表 + 独立时钟 + TL2 式时间戳验证 + 计数日志
+struct CompactPolicy : DefaultPolicy {
+    static constexpr int kMaxHistory = 2;
+    static constexpr size_t kDescriptorCapacity = 4;
+    using LockTable = BasicStripedLockTable<10>;
+    using Clock = BasicGlobalClock<IsolatedClockTag>;
+    using Validation = TimestampValidation;
+    using Logger = CountingLogger;
+};
+
+using CompactTx = BasicTransaction<CompactPolicy>;
+using CompactDesc = BasicTransactionDescriptor<CompactPolicy>;
+
+template<typename T>
+using CompactVar = TMVar<T, CompactPolicy>;
+
+}
+
+// 默认配置下的别名必须保持原有类型
+TEST(OccPolicyTest, DefaultAliasesAreUnchanged) {
+    static_assert(std::is_same_v<Transaction, BasicTransaction<DefaultPolicy>>);
+    static_assert(std::is_same_v<TransactionDescriptor, BasicTransactionDescriptor<DefaultPolicy>>);
+    static_assert(std::is_same_v<STM::Var<int>, TMVar<int, DefaultPolicy>>);
+    static_assert(TMVar<int>::MAX_HISTORY == 8);
+    static_assert(StripedLockTable::kTableSize == (1u << 20));
+    static_assert(TransactionDescriptor::kDefaultCapacity == 16);
+}
+
+// 策略参数应当传递到各组件
+TEST(OccPolicyTest, TunablesFollowPolicy) {
+    static_assert(CompactVar<int>::MAX_HISTORY == 2);
+    static_assert(CompactPolicy::LockTable::kTableSize == 1024);
+    static_assert(CompactDesc::kDefaultCapacity == 4);
+
+    // 独立时钟域不影响默认时钟
+    uint64_t default_now = GlobalClock::now();
+    CompactPolicy::Clock::tick();
+    CompactPolicy::Clock::tick();
+    EXPECT_EQ(GlobalClock::now(), default_now);
+}
+
+// 浅历史：提交 3 次后，RV=0 的老事务已经找不到可见版本
+TEST(OccPolicyTest, ShallowHistoryPrunesEarlier) {
+    CompactVar<int> var(0);
+    CompactDesc desc_updater;
+    CompactTx updater(&desc_updater);
+
+    for (int i = 1; i <= 4; ++i) {
+        updater.begin();
+        updater.store(var, i);
+        ASSERT_TRUE(updater.commit());
+    }
+
+    CompactDesc desc_old;
+    CompactTx old_tx(&desc_old);
+    old_tx.begin();
+    desc_old.setReadVersion(0);
+    EXPECT_THROW(old_tx.load(var), RetryException);
+    old_tx.abort();
+}
+
+// 时间戳验证同样能发现读写冲突，并且计数日志记录了结果
+TEST(OccPolicyTest, TimestampValidationDetectsConflict) {
+    CompactVar<int> x(10);
+    CompactVar<int> y(20);
+
+    CompactDesc desc, desc_other;
+    CompactTx tx(&desc);
+    CompactTx other(&desc_other);
+
+    auto before = CountingLogger::local();
+
+    tx.begin();
+    EXPECT_EQ(tx.load(x), 10);
+
+    other.begin();
+    other.store(x, 11);
+    EXPECT_TRUE(other.commit());
+
+    tx.store(y, 21);
+    EXPECT_FALSE(tx.commit());
+
+    auto after = CountingLogger::local();
+    EXPECT_EQ(after.commits - before.commits, 1u);
+    EXPECT_EQ(after.aborts - before.aborts, 1u);
+    EXPECT_EQ(after.begins - before.begins, 2u);
+}
+
+// 时间戳验证的边界：提交者已持锁并 tick 出 wv，读者随后 begin 得到 rv == wv，
+// 在新版本挂链之前读到旧值。这次读取必须失败，否则读者提交时 write_ts <= rv 会放过丢失更新
+TEST(OccPolicyTest, TimestampValidationRejectsReadUnderCommit) {
+    using Node = CompactVar<int>::Node;
+
+    CompactVar<int> x(0);
+    auto& lock_table = CompactPolicy::LockTable::instance();
+    size_t idx = lock_table.getStripeIndex(&x);
+
+    // 提交者：加锁 -> tick
+    lock_table.lockByIndex(idx);
+    uint64_t wv = CompactPolicy::Clock::tick();
+
+    CompactDesc desc;
+    CompactTx reader(&desc);
+    reader.begin();
+    ASSERT_EQ(desc.getReadVersion(), wv);
+
+    bool conflicted = false;
+    try {
+        reader.store(x, reader.load(x) + 1);
+    }
+    catch (const RetryException&) {
+        conflicted = true;
+        reader.abort();
+    }
+
+    // 提交者：挂链 (write_ts == rv) -> 解锁
+    CompactVar<int>::committer(&x, new Node(0, nullptr, 100), wv);
+    lock_table.unlockByIndex(idx);
+
+    if (!conflicted) conflicted = !reader.commit();
+
+    EXPECT_TRUE(conflicted);
+    EXPECT_EQ(x.unsafeLoad(), 100);
+}
+
+// 自定义策略的 atomically 并发累加
+TEST(OccPolicyTest, ConcurrentCounterWithCustomPolicy) {
+    CompactVar<int> counter(0);
+
+    const int NUM_THREADS = 4;
+    const int INC_PER_THREAD = 500;
+
+    std::vector<std::thread> workers;
+    for (int i = 0; i < NUM_THREADS; ++i) {
+        workers.emplace_back([&]() {
+            for (int j = 0; j < INC_PER_THREAD; ++j) {
+                STM::atomically<CompactPolicy>([&](CompactTx& tx) {
+                    tx.store(counter, tx.load(counter) + 1);
+                });
+            }
+        });
+    }
+    for (auto& t : workers) t.join();
+
+    int final_val = STM::atomically<CompactPolicy>([&](CompactTx& tx) {
+        return tx.load(counter);
+    });
+    EXPECT_EQ(final_val, NUM_THREADS * INC_PER_THREAD);
+}
@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "OccSTM/STM.hpp"
+
+using namespace STM::Occ;
+
+namespace {
+
+struct Subtree {
+    STM::Var<int> a;
+    STM::Var<int> b;
+
+    Subtree(int x, int y) : a(x), b(y) {}
+};
+
+}
+
+TEST(OccPrivatizeTest, UnsafeAccessorsReadWriteCurrentVersion) {
+    STM::Var<int> x(1);
+
+    EXPECT_EQ(x.unsafeLoad(), 1);
+    x.unsafeStore(5);
+    EXPECT_EQ(x.unsafeLoad(), 5);
+
+    int seen = STM::atomically([&](Transaction& tx) { return tx.load(x); });
+    EXPECT_EQ(seen, 5);
+}
+
+// 摘下子树 -> privatize -> 非事务修改；并发读者在摘下之后不会再看到它
+TEST(OccPrivatizeTest, DetachThenPrivatize) {
+    auto* subtree = new Subtree(10, 20);
+    STM::Var<Subtree*> root(subtree);
+
+    std::atomic<bool> stop{false};
+    std::atomic<long> bad_sums{0};
+
+    // 读者：子树挂着时，a + b 恒为 30
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 2; ++i) {
+        readers.emplace_back([&]() {
+            while (!stop.load()) {
+                STM::atomically([&](Transaction& tx) {
+                    Subtree* s = tx.load(root);
+                    if (s == nullptr) return;
+                    if (tx.load(s->a) + tx.load(s->b) != 30) bad_sums.fetch_add(1);
+                });
+            }
+        });
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    Subtree* detached = STM::atomically([&](Transaction& tx) {
+        Subtree* s = tx.load(root);
+        tx.store(root, static_cast<Subtree*>(nullptr));
+        return s;
+    });
+
+    STM::privatize();
+
+    // 私有化后批量维护：破坏不变量也不会被任何读者观察到
+    detached->a.unsafeStore(detached->a.unsafeLoad() + 1000);
+    detached->b.unsafeStore(0);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    stop.store(true);
+    for (auto& r : readers) r.join();
+
+    EXPECT_EQ(bad_sums.load(), 0);
+    EXPECT_EQ(detached->a.unsafeLoad(), 1010);
+    delete detached;
+}
@@ -0,0 +1,194 @@
+#include <gtest/gtest.h>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+#include "OccSTM/STM.hpp"
+#include "OccSTM/TArray.hpp"
+
+using namespace STM::Occ;
+
+TEST(OccTArrayTest, LoadStoreSlots) {
+    TArray<long, 100> arr(7);
+    EXPECT_EQ(arr.size(), 100u);
+
+    STM::atomically([&](Transaction& tx) {
+        EXPECT_EQ(arr.load(tx, 42), 7);
+        arr.store(tx, 42, 1);
+        arr.store(tx, 43, 2);
+        EXPECT_EQ(arr.load(tx, 42), 1);
+        EXPECT_EQ(arr.load(tx, 43), 2);
+        EXPECT_EQ(arr.load(tx, 44), 7);
+    });
+
+    EXPECT_EQ(arr.unsafeLoad(42), 1);
+    EXPECT_EQ(arr.unsafeLoad(43), 2);
+    EXPECT_EQ(arr.unsafeLoad(99), 7);
+}
+
+TEST(OccTArrayTest, LoadRangeCrossesBlocks) {
+    TDynArray<int> arr(50);
+    for (size_t i = 0; i < arr.size(); ++i) arr.unsafeStore(i, static_cast<int>(i));
+
+    std::vector<int> out;
+    STM::atomically([&](Transaction& tx) {
+        out.clear();
+        arr.store(tx, 20, -1);
+        arr.loadRange(tx, 5, 40, std::back_inserter(out));
+    });
+
+    ASSERT_EQ(out.size(), 40u);
+    for (size_t k = 0; k < out.size(); ++k) {
+        EXPECT_EQ(out[k], k + 5 == 20 ? -1 : static_cast<int>(k + 5));
+    }
+}
+
+// 只写不读：同一块内不同槽位的写入在提交时合并
+TEST(OccTArrayTest, BlindStoresToSameBlockMerge) {
+    TArray<long, 8, DefaultPolicy, 8> arr;
+    TransactionDescriptor desc_a, desc_b;
+    Transaction a(&desc_a);
+    Transaction b(&desc_b);
+
+    a.begin();
+    b.begin();
+    arr.store(a, 0, 10);
+    arr.store(b, 1, 20);
+    EXPECT_TRUE(b.commit());
+    EXPECT_TRUE(a.commit());
+
+    EXPECT_EQ(arr.unsafeLoad(0), 10);
+    EXPECT_EQ(arr.unsafeLoad(1), 20);
+}
+
+// 单槽写入记为内联的元素补丁，不构造闭包；非平凡元素退回闭包补丁
+TEST(OccTArrayTest, SlotStoresUseInlinePatches) {
+    using Arr = TArray<long, 8, DefaultPolicy, 8>;
+    Arr arr;
+    TransactionDescriptor desc;
+    Transaction tx(&desc);
+
+    tx.begin();
+    arr.store(tx, 2, 5);
+    arr.store(tx, 3, 6);
+    ASSERT_EQ(desc.writeSet().size(), 1u);
+    auto* patch = static_cast<const detail::FieldPatch<Arr::Block>*>(desc.writeSet().front().new_node);
+    EXPECT_TRUE(patch->fns.empty());
+    EXPECT_EQ(arr.load(tx, 3), 6);
+    EXPECT_TRUE(tx.commit());
+    EXPECT_EQ(arr.unsafeLoad(2), 5);
+    EXPECT_EQ(arr.unsafeLoad(3), 6);
+
+    TArray<std::string, 4, DefaultPolicy, 4> names(std::string("-"));
+    STM::atomically([&](Transaction& t) { names.store(t, 1, std::string("b")); });
+    EXPECT_EQ(names.unsafeLoad(0), "-");
+    EXPECT_EQ(names.unsafeLoad(1), "b");
+}
+
+// 同一块先写后读：读取不能把槽位补丁物化成整块写入
+TEST(OccTArrayTest, LoadAfterStoreKeepsSlotPatch) {
+    using Arr = TArray<long, 8, DefaultPolicy, 8>;
+    Arr arr(1);
+    TransactionDescriptor desc;
+    Transaction tx(&desc);
+
+    tx.begin();
+    arr.store(tx, 2, 5);
+    EXPECT_EQ(arr.load(tx, 3), 1);
+    EXPECT_EQ(arr.load(tx, 2), 5);
+
+    std::vector<long> out;
+    arr.loadRange(tx, 0, 8, std::back_inserter(out));
+    EXPECT_EQ(std::accumulate(out.begin(), out.end(), 0L), 7 + 5);
+
+    ASSERT_EQ(desc.writeSet().size(), 1u);
+    EXPECT_EQ(desc.writeSet().front().committer, &TMVar<Arr::Block>::patchCommitter);
+    EXPECT_TRUE(tx.commit());
+    EXPECT_EQ(arr.unsafeLoad(2), 5);
+    EXPECT_EQ(arr.unsafeLoad(3), 1);
+}
+
+// 版本以块为粒度：读过的块中任意槽位被改都会导致验证失败
+TEST(OccTArrayTest, ReadBlockConflictsWithNeighbourWrite) {
+    TArray<long, 8, DefaultPolicy, 8> arr;
+    TArray<long, 1> out;
+    TransactionDescriptor desc_a, desc_b;
+    Transaction a(&desc_a);
+    Transaction b(&desc_b);
+
+    a.begin();
+    long seen = arr.load(a, 0);
+
+    b.begin();
+    arr.store(b, 1, 5);
+    EXPECT_TRUE(b.commit());
+
+    out.store(a, 0, seen + 1);
+    EXPECT_FALSE(a.commit());
+    EXPECT_EQ(out.unsafeLoad(0), 0);
+}
+
+TEST(OccTArrayTest, EagerPolicy) {
+    TArray<int, 20, EagerPolicy> arr(1);
+
+    STM::atomically<EagerPolicy>([&](BasicTransaction<EagerPolicy>& tx) {
+        arr.store(tx, 3, 9);
+        std::vector<int> out;
+        arr.loadRange(tx, 0, 20, std::back_inserter(out));
+        EXPECT_EQ(std::accumulate(out.begin(), out.end(), 0), 19 + 9);
+    });
+
+    EXPECT_EQ(arr.unsafeLoad(3), 9);
+}
+
+// 初始版本被历史裁剪退休后数组仍可访问；数组可以在事务内析构，区域经 EBR 回收
+TEST(OccTArrayTest, TrimmedInitialVersionsAndDeferredDestruction) {
+    auto* arr = new TDynArray<std::string>(40, std::string("init"));
+    for (int i = 0; i < 4 * TMVar<int>::MAX_HISTORY; ++i) {
+        STM::atomically([&](Transaction& tx) { arr->store(tx, 0, std::to_string(i)); });
+    }
+    EXPECT_EQ(arr->unsafeLoad(1), "init");
+
+    STM::atomically([&](Transaction& tx) {
+        EXPECT_EQ(arr->load(tx, 2), "init");
+    });
+    STM::atomically([&](Transaction&) { delete arr; });
+    EBRManager::instance()->synchronize();
+
+    for (int i = 0; i < 1000; ++i) {
+        STM::atomically([&](Transaction& tx) {
+            TArray<int, 16> small(i);
+            EXPECT_EQ(small.load(tx, 15), i);
+        });
+    }
+    EBRManager::instance()->synchronize();
+}
+
+// 并发直方图：各线程随机累加，总数守恒
+TEST(OccTArrayTest, ConcurrentHistogram) {
+    TArray<long, 64> hist;
+    const int kThreads = 4;
+    const int kOps = 1000;
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < kThreads; ++t) {
+        workers.emplace_back([&, t]() {
+            unsigned seed = 2654435761u * static_cast<unsigned>(t + 1);
+            for (int i = 0; i < kOps; ++i) {
+                seed = seed * 1103515245u + 12345u;
+                size_t bucket = (seed >> 8) % hist.size();
+                STM::atomically([&](Transaction& tx) {
+                    hist.store(tx, bucket, hist.load(tx, bucket) + 1);
+                });
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+
+    long total = STM::atomically([&](Transaction& tx) {
+        std::vector<long> all;
+        hist.loadRange(tx, 0, hist.size(), std::back_inserter(all));
+        return std::accumulate(all.begin(), all.end(), 0L);
+    });
+    EXPECT_EQ(total, kThreads * kOps);
+}
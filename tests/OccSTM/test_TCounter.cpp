@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+#include "OccSTM/STM.hpp"
+#include "OccSTM/TCounter.hpp"
+
+using namespace STM::Occ;
+
+namespace {
+
+template<typename Policy>
+long readCounter(BasicTCounter<Policy>& counter) {
+    return STM::atomically<Policy>([&](BasicTransaction<Policy>& tx) { return counter.get(tx); });
+}
+
+}
+
+// ==========================================
+// 1. tx.increment
+// ==========================================
+
+// 增量与本事务中更早的写入、已提交值正确叠加
+TEST(OccTCounterTest, IncrementComposesWithOwnWrites) {
+    STM::Var<int> x(10);
+
+    STM::atomically([&](Transaction& tx) {
+        tx.increment(x, 5);
+        EXPECT_EQ(tx.load(x), 15);
+        tx.increment(x, 1);
+        EXPECT_EQ(tx.load(x), 16);
+        tx.store(x, 100);
+        tx.increment(x, 2);
+        EXPECT_EQ(tx.load(x), 102);
+    });
+
+    int val = STM::atomically([&](Transaction& tx) { return tx.load(x); });
+    EXPECT_EQ(val, 102);
+}
+
+// 只做 increment 的事务不进入读集：别人并发提交也不会导致中止
+TEST(OccTCounterTest, BlindIncrementsDoNotConflict) {
+    STM::Var<long> x(0);
+
+    TransactionDescriptor desc, desc_other;
+    Transaction tx(&desc);
+    Transaction other(&desc_other);
+
+    tx.begin();
+    tx.increment(x, 1L);
+    EXPECT_TRUE(desc.readSet().empty());
+
+    other.begin();
+    other.increment(x, 10L);
+    EXPECT_TRUE(other.commit());
+
+    EXPECT_TRUE(tx.commit());
+    EXPECT_EQ(x.loadHead()->payload, 11);
+}
+
+// ==========================================
+// 2. TCounter
+// ==========================================
+TEST(OccTCounterTest, AddAndGet) {
+    TCounter counter(7);
+
+    STM::atomically([&](Transaction& tx) {
+        counter.add(tx, 3);
+        EXPECT_EQ(counter.get(tx), 10);
+    });
+
+    EXPECT_EQ(readCounter(counter), 10);
+}
+
+// get 读取全部分片：之后有 add 提交，读者的写事务要重做
+TEST(OccTCounterTest, ExactReadValidatesShards) {
+    TCounter counter;
+    STM::Var<long> snapshot(0);
+
+    TransactionDescriptor desc;
+    Transaction tx(&desc);
+
+    tx.begin();
+    long seen = counter.get(tx);
+
+    STM::atomically([&](Transaction& other) { counter.add(other, 1); });
+
+    tx.store(snapshot, seen);
+    EXPECT_FALSE(tx.commit());
+}
+
+template<typename Policy>
+void concurrentInserts() {
+    BasicTCounter<Policy> size;
+
+    const int NUM_THREADS = 4;
+    const int OPS_PER_THREAD = 1000;
+
+    // 各线程插入互不相交的槽位并维护全局 size
+    std::vector<TMVar<int, Policy>*> slots;
+    for (int i = 0; i < NUM_THREADS * OPS_PER_THREAD; ++i) slots.push_back(new TMVar<int, Policy>(0));
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < NUM_THREADS; ++t) {
+        workers.emplace_back([&, t]() {
+            for (int i = 0; i < OPS_PER_THREAD; ++i) {
+                STM::atomically<Policy>([&](BasicTransaction<Policy>& tx) {
+                    tx.store(*slots[t * OPS_PER_THREAD + i], 1);
+                    size.add(tx, 1);
+                });
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+
+    EXPECT_EQ(readCounter(size), NUM_THREADS * OPS_PER_THREAD);
+
+    for (auto* s : slots) delete s;
+}
+
+TEST(OccTCounterTest, ConcurrentInsertsKeepExactSize) {
+    concurrentInserts<DefaultPolicy>();
+}
+
+TEST(OccTCounterTest, ConcurrentInsertsKeepExactSizeEager) {
+    concurrentInserts<EagerPolicy>();
+}
@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "OccSTM/STM.hpp"
+#include "OccSTM/TMVarArena.hpp"
+
+using namespace STM::Occ;
+
+// 跨越多个 2MB 块的批量构造
+TEST(OccTMVarArenaTest, BuildsAcrossChunks) {
+    const size_t N = 200000;
+    TMVarArena<long> arena(N, [](size_t i) { return static_cast<long>(i * 3); });
+
+    ASSERT_EQ(arena.size(), N);
+    EXPECT_EQ(arena[0].unsafeLoad(), 0);
+    EXPECT_EQ(arena[N - 1].unsafeLoad(), static_cast<long>((N - 1) * 3));
+
+    long sum = STM::atomically([&](Transaction& tx) {
+        return tx.load(arena[12345]) + tx.load(arena[N / 2]);
+    });
+    EXPECT_EQ(sum, 12345 * 3 + static_cast<long>(N / 2) * 3);
+}
+
+// 非平凡类型：payload 的析构随 arena 一起发生
+TEST(OccTMVarArenaTest, NonTrivialPayload) {
+    TMVarArena<std::string> arena(1000, [](size_t i) { return std::string(40, 'a' + i % 26); });
+
+    STM::atomically([&](Transaction& tx) {
+        tx.store(arena[3], tx.load(arena[3]) + "!");
+    });
+
+    EXPECT_EQ(arena[3].unsafeLoad(), std::string(40, 'd') + "!");
+    EXPECT_EQ(arena[4].unsafeLoad(), std::string(40, 'e'));
+}
+
+// 构造中途 gen 抛异常：已构造的变量被析构、块被归还，在 atomically 内也不会等待自己的纪元
+TEST(OccTMVarArenaTest, ThrowingGeneratorInsideTransaction) {
+    EXPECT_THROW(STM::atomically([&](Transaction&) {
+        TMVarArena<std::string> arena(100, [](size_t i) {
+            if (i == 60) throw std::runtime_error("bad input");
+            return std::to_string(i);
+        });
+    }), std::runtime_error);
+}
+
+// 反复提交直到块内初始节点被历史裁剪、交给 EBR；arena 析构后堆仍可正常使用
+TEST(OccTMVarArenaTest, PrunedInitialNodesAreReclaimedBeforeRelease) {
+    {
+        TMVarArena<int> arena(64, [](size_t i) { return static_cast<int>(i); });
+
+        for (int round = 0; round < 3 * TMVar<int>::MAX_HISTORY; ++round) {
+            STM::atomically([&](Transaction& tx) {
+                for (size_t i = 0; i < arena.size(); ++i) {
+                    tx.store(arena[i], tx.load(arena[i]) + 1);
+                }
+            });
+        }
+
+        int v = STM::atomically([&](Transaction& tx) { return tx.load(arena[10]); });
+        EXPECT_EQ(v, 10 + 3 * TMVar<int>::MAX_HISTORY);
+    }
+
+    // 归还的块可能被复用为小对象 Slab
+    std::vector<STM::Var<long>*> vars;
+    for (int i = 0; i < 10000; ++i) vars.push_back(new STM::Var<long>(i));
+    for (auto* v : vars) delete v;
+}
+
+// 装载阶段结束后通过一次事务发布，并发读者只会看到完整的数据
+TEST(OccTMVarArenaTest, SinglePublication) {
+    using Arena = TMVarArena<int>;
+    STM::Var<Arena*> published(nullptr);
+
+    std::atomic<bool> stop{false};
+    std::atomic<int> bad{0};
+
+    std::thread reader([&]() {
+        while (!stop.load()) {
+            STM::atomically([&](Transaction& tx) {
+                Arena* a = tx.load(published);
+                if (a && tx.load((*a)[999]) != 1999) bad.fetch_add(1);
+            });
+        }
+    });
+
+    Arena* arena = new Arena(1000, [](size_t) { return 0; });
+    for (size_t i = 0; i < arena->size(); ++i) {
+        (*arena)[i].unsafeStore(static_cast<int>(i + 1000));
+    }
+    STM::atomically([&](Transaction& tx) { tx.store(published, arena); });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    stop.store(true);
+    reader.join();
+
+    EXPECT_EQ(bad.load(), 0);
+
+    STM::atomically([&](Transaction& tx) { tx.store(published, static_cast<Arena*>(nullptr)); });
+    delete arena;
+}
@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "OccSTM/STM.hpp"
+#include "OccSTM/TPtr.hpp"
+
+using namespace STM::Occ;
+
+namespace {
+
+std::atomic<int> g_live{0};
+
+struct Tracked {
+    int value;
+    explicit Tracked(int v) : value(v) { g_live.fetch_add(1); }
+    ~Tracked() { g_live.fetch_sub(1); }
+};
+
+void quiesce() { EBRManager::instance()->synchronize(); }
+
+}
+
+// 1. 替换：旧对象在提交后回收
+TEST(OccTPtrTest, ReplaceRetiresOldOnCommit) {
+    g_live = 0;
+    {
+        TPtr<Tracked> p(std::in_place, 1);
+        EXPECT_EQ(g_live.load(), 1);
+
+        STM::atomically([&](Transaction& tx) { p.make(tx, 2); });
+        quiesce();
+
+        EXPECT_EQ(g_live.load(), 1);
+        EXPECT_EQ(p.unsafeGet()->value, 2);
+
+        STM::atomically([&](Transaction& tx) { p.reset(tx); });
+        quiesce();
+
+        EXPECT_EQ(g_live.load(), 0);
+        EXPECT_EQ(p.unsafeGet(), nullptr);
+    }
+    EXPECT_EQ(g_live.load(), 0);
+}
+
+// 2. 中止：旧对象保留，本次尝试新建的对象被回收
+TEST(OccTPtrTest, AbortCancelsRetirement) {
+    g_live = 0;
+    {
+        TPtr<Tracked> p(std::in_place, 1);
+        Tracked* original = p.unsafeGet();
+
+        int attempts = 0;
+        STM::atomically([&](Transaction& tx) {
+            p.make(tx, 10 + attempts);
+            if (attempts++ < 2) throw RetryException();
+        });
+        quiesce();
+
+        // 两次中止的尝试各新建了一个对象，都已回收；original 在最后一次提交后回收
+        EXPECT_EQ(g_live.load(), 1);
+        EXPECT_EQ(p.unsafeGet()->value, 12);
+        EXPECT_NE(p.unsafeGet(), original);
+    }
+    EXPECT_EQ(g_live.load(), 0);
+}
+
+// 3. 同一事务内多次替换：中间对象也随提交回收
+TEST(OccTPtrTest, RepeatedReplaceInOneTransaction) {
+    g_live = 0;
+    {
+        TPtr<Tracked> p;
+        STM::atomically([&](Transaction& tx) {
+            p.make(tx, 1);
+            p.make(tx, 2);
+            EXPECT_EQ(p.get(tx)->value, 2);
+            p.make(tx, 3);
+        });
+        quiesce();
+
+        EXPECT_EQ(g_live.load(), 1);
+        EXPECT_EQ(p.unsafeGet()->value, 3);
+    }
+    EXPECT_EQ(g_live.load(), 0);
+}
+
+TEST(OccTPtrTest, ReleaseTransfersOwnership) {
+    g_live = 0;
+    Tracked* taken = nullptr;
+    {
+        TPtr<Tracked> p(std::in_place, 7);
+        taken = STM::atomically([&](Transaction& tx) { return p.release(tx); });
+        quiesce();
+        EXPECT_EQ(p.unsafeGet(), nullptr);
+    }
+    EXPECT_EQ(g_live.load(), 1);
+    EXPECT_EQ(taken->value, 7);
+
+    taken->~Tracked();
+    ThreadHeap::deallocate(taken);
+    EXPECT_EQ(g_live.load(), 0);
+}
+
+// fork 子事务中的替换：包括兄弟冲突导致的串行重做，都不泄漏
+TEST(OccTPtrTest, ReplaceInForkChild) {
+    g_live = 0;
+    {
+        TPtr<Tracked> p(std::in_place, 1), q(std::in_place, 2);
+
+        STM::atomically([&](Transaction& tx) {
+            tx.fork(
+                [&](Transaction& child) { p.make(child, 10); },
+                [&](Transaction& child) { q.make(child, 20); });
+        });
+        quiesce();
+        EXPECT_EQ(g_live.load(), 2);
+
+        STM::atomically([&](Transaction& tx) {
+            tx.fork(
+                [&](Transaction& child) { p.make(child, p.get(child)->value + 1); },
+                [&](Transaction& child) { q.make(child, p.get(child)->value * 2); });
+        });
+        quiesce();
+        EXPECT_EQ(p.unsafeGet()->value, 11);
+        EXPECT_EQ(q.unsafeGet()->value, 22);
+        EXPECT_EQ(g_live.load(), 2);
+    }
+    EXPECT_EQ(g_live.load(), 0);
+}
+
+// 4. 并发替换与读取：读者拿到的对象在事务内始终有效，最终没有泄漏
+TEST(OccTPtrTest, ConcurrentReplaceIsBounded) {
+    g_live = 0;
+    {
+        TPtr<Tracked> p(std::in_place, 0);
+        const int kWriters = 3;
+        const int kOps = 2000;
+        std::atomic<bool> stop{false};
+
+        std::thread reader([&]() {
+            while (!stop.load()) {
+                STM::atomically([&](Transaction& tx) {
+                    Tracked* t = p.get(tx);
+                    EXPECT_GE(t->value, 0);
+                });
+            }
+        });
+
+        std::vector<std::thread> writers;
+        for (int w = 0; w < kWriters; ++w) {
+            writers.emplace_back([&]() {
+                for (int i = 0; i < kOps; ++i) {
+                    STM::atomically([&](Transaction& tx) { p.make(tx, p.get(tx)->value + 1); });
+                }
+            });
+        }
+        for (auto& t : writers) t.join();
+        stop = true;
+        reader.join();
+
+        quiesce();
+        EXPECT_EQ(p.unsafeGet()->value, kWriters * kOps);
+        EXPECT_EQ(g_live.load(), 1);
+    }
+    EXPECT_EQ(g_live.load(), 0);
+}
@@ -1,4 +1,6 @@
 #include <gtest/gtest.h>
+#include <string>
+#include <vector>
 #include "OccSTM/Transaction.hpp"
 
 // 假设这些组件已经正确实现并链接
@@ -64,6 +66,64 @@ TEST_F(TransactionTest, ReadYourOwnWrites) {
     EXPECT_EQ(var.loadHead()->payload, 30);
 }
 
+namespace {
+
+// 统计拷贝次数的负载
+struct CopyCounted {
+    static inline int copies = 0;
+
+    std::vector<int> data;
+
+    CopyCounted(size_t n, int v) : data(n, v) {}
+    CopyCounted(const CopyCounted& other) : data(other.data) { ++copies; }
+    CopyCounted(CopyCounted&&) noexcept = default;
+    CopyCounted& operator=(const CopyCounted&) = default;
+    CopyCounted& operator=(CopyCounted&&) noexcept = default;
+};
+
+}
+
+// 测试：右值 store 与 emplace 直接在新版本节点内构造，不产生拷贝
+TEST_F(TransactionTest, MoveStoreAndEmplaceAvoidCopies) {
+    TMVar<CopyCounted> var(size_t(4), 0);
+    Transaction tx(&desc);
+    CopyCounted::copies = 0;
+
+    tx.begin();
+    tx.store(var, CopyCounted(8, 1));
+    EXPECT_EQ(tx.load(var).data.size(), 8u);
+    tx.emplace(var, size_t(16), 2);
+    EXPECT_TRUE(tx.commit());
+
+    EXPECT_EQ(var.loadHead()->payload.data.size(), 16u);
+    EXPECT_EQ(var.loadHead()->payload.data[0], 2);
+    // 只有 load 返回值时拷贝了一次
+    EXPECT_EQ(CopyCounted::copies, 1);
+
+    // 左值仍走拷贝版本，源对象不受影响
+    CopyCounted local(2, 3);
+    tx.begin();
+    tx.store(var, local);
+    EXPECT_TRUE(tx.commit());
+    EXPECT_EQ(local.data.size(), 2u);
+    EXPECT_EQ(var.loadHead()->payload.data[0], 3);
+}
+
+TEST_F(TransactionTest, MoveStoreString) {
+    TMVar<std::string> var(std::string("init"));
+    Transaction tx(&desc);
+
+    std::string big(1024, 'x');
+    const char* buffer = big.data();
+
+    tx.begin();
+    tx.store(var, std::move(big));
+    EXPECT_TRUE(tx.commit());
+
+    // 长字符串的缓冲区被直接移入节点
+    EXPECT_EQ(var.loadHead()->payload.data(), buffer);
+}
+
 // ============================================================================
 // 2. Occ 与隔离性测试
 // ============================================================================
@@ -0,0 +1,173 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "OccSTM/STM.hpp"
+#include "OccSTM/TxExecutor.hpp"
+
+using namespace STM::Occ;
+
+TEST(OccTxExecutorTest, FuturesCarryResults) {
+    STM::Var<int> x(41);
+    TxExecutor exec(2);
+
+    auto answer = exec.submit([&](Transaction& tx) { return tx.load(x) + 1; });
+    auto done = exec.submit([&](Transaction& tx) { tx.store(x, 0); });
+
+    int a = answer.get();
+    EXPECT_TRUE(a == 42 || a == 1);
+    done.get();
+    EXPECT_EQ(x.unsafeLoad(), 0);
+}
+
+TEST(OccTxExecutorTest, ExceptionsReachTheFuture) {
+    STM::Var<int> x(1);
+    TxExecutor exec(2);
+
+    auto f = exec.submit([&](Transaction& tx) -> int {
+        tx.store(x, 2);
+        throw std::runtime_error("boom");
+    });
+
+    EXPECT_THROW(f.get(), std::runtime_error);
+    EXPECT_EQ(x.unsafeLoad(), 1);
+}
+
+// 析构会等所有已提交的任务执行完
+TEST(OccTxExecutorTest, DestructorDrainsQueuedTasks) {
+    STM::Var<long> counter(0);
+    {
+        TxExecutor exec(3);
+        for (int i = 0; i < 50; ++i) {
+            exec.submit([&](Transaction& tx) { tx.store(counter, tx.load(counter) + 1); });
+        }
+    }
+    EXPECT_EQ(counter.unsafeLoad(), 50);
+}
+
+// 偏斜负载：大部分任务争用同一个变量，结果必须精确
+TEST(OccTxExecutorTest, SkewedCounters) {
+    STM::Var<long> hot(0);
+    std::vector<STM::Var<long>*> cold;
+    for (int i = 0; i < 8; ++i) cold.push_back(new STM::Var<long>(0L));
+
+    const int kTasks = 2000;
+    {
+        TxExecutor exec(4);
+        std::vector<std::future<void>> futures;
+        for (int i = 0; i < kTasks; ++i) {
+            futures.push_back(exec.submit([&, i](Transaction& tx) {
+                tx.store(hot, tx.load(hot) + 1);
+                STM::Var<long>& c = *cold[i % cold.size()];
+                tx.store(c, tx.load(c) + 1);
+            }));
+        }
+        for (auto& f : futures) f.get();
+    }
+
+    EXPECT_EQ(hot.unsafeLoad(), kTasks);
+    long sum = 0;
+    for (auto* c : cold) {
+        sum += c->unsafeLoad();
+        delete c;
+    }
+    EXPECT_EQ(sum, kTasks);
+}
+
+// 争用同一变量的任务在中止后被迁移到属主线程，结果仍然精确
+TEST(OccTxExecutorTest, ConflictingTasksMigrate) {
+    STM::Var<long> hot(0);
+    const int kTasks = 400;
+    size_t migrations = 0;
+    {
+        TxExecutor exec(4);
+        std::vector<std::future<void>> futures;
+        for (int i = 0; i < kTasks; ++i) {
+            futures.push_back(exec.submit([&](Transaction& tx) {
+                long v = tx.load(hot);
+                // 拉长读写之间的窗口，让其他工作线程插进来提交
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+                tx.store(hot, v + 1);
+            }));
+        }
+        for (auto& f : futures) f.get();
+        migrations = exec.migrations();
+    }
+
+    EXPECT_EQ(hot.unsafeLoad(), kTasks);
+    EXPECT_GT(migrations, 0u);
+}
+
+// 不开启冲突感知时从不迁移
+TEST(OccTxExecutorTest, ConflictBlindExecutorNeverMigrates) {
+    STM::Var<long> hot(0);
+    {
+        TxExecutor exec(3, false);
+        std::vector<std::future<void>> futures;
+        for (int i = 0; i < 100; ++i) {
+            futures.push_back(exec.submit([&](Transaction& tx) {
+                long v = tx.load(hot);
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+                tx.store(hot, v + 1);
+            }));
+        }
+        for (auto& f : futures) f.get();
+        EXPECT_EQ(exec.migrations(), 0u);
+    }
+    EXPECT_EQ(hot.unsafeLoad(), 100);
+}
+
+TEST(OccTxExecutorTest, EagerPolicyTasks) {
+    STM::Var<long, EagerPolicy> counter(0);
+    {
+        TxExecutor exec(2, false);
+        for (int i = 0; i < 200; ++i) {
+            exec.submit<EagerPolicy>([&](BasicTransaction<EagerPolicy>& tx) {
+                tx.store(counter, tx.load(counter) + 1);
+            });
+        }
+    }
+    EXPECT_EQ(counter.unsafeLoad(), 200);
+}
+
+// 验证失败时描述符记下冲突变量，供调度器使用
+TEST(OccTxExecutorTest, FailedValidationLeavesConflictHint) {
+    STM::Var<int> x(1);
+    STM::Var<int> y(1);
+    TransactionDescriptor desc, desc_other;
+    Transaction tx(&desc);
+    Transaction other(&desc_other);
+
+    tx.begin();
+    tx.load(x);
+
+    other.begin();
+    other.store(x, 2);
+    EXPECT_TRUE(other.commit());
+
+    tx.store(y, 3);
+    EXPECT_FALSE(tx.commit());
+    EXPECT_EQ(desc.takeConflict(), &x);
+    EXPECT_EQ(desc.takeConflict(), nullptr);
+}
+
+// 单变量读-改-写的快速提交路径同样留下冲突变量
+TEST(OccTxExecutorTest, SingleVarCommitLeavesConflictHint) {
+    STM::Var<int> x(1);
+    TransactionDescriptor desc, desc_other;
+    Transaction tx(&desc);
+    Transaction other(&desc_other);
+
+    tx.begin();
+    int v = tx.load(x);
+
+    other.begin();
+    other.store(x, 2);
+    EXPECT_TRUE(other.commit());
+
+    tx.store(x, v + 1);
+    EXPECT_FALSE(tx.commit());
+    EXPECT_EQ(desc.takeConflict(), &x);
+}
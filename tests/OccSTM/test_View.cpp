@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <thread>
+#include <vector>
+#include "OccSTM/STM.hpp"
+
+using namespace STM::Occ;
+
+namespace {
+
+struct Big {
+    std::array<long, 512> data{};
+
+    explicit Big(long v = 0) { data.fill(v); }
+
+    long sum() const {
+        long s = 0;
+        for (long x : data) s += x;
+        return s;
+    }
+};
+
+}
+
+TEST(OccViewTest, ViewMatchesLoad) {
+    STM::Var<Big> var(Big(3));
+
+    STM::atomically([&](Transaction& tx) {
+        const Big& v = tx.view(var);
+        EXPECT_EQ(v.sum(), tx.load(var).sum());
+        EXPECT_EQ(&v, &tx.view(var));
+    });
+}
+
+TEST(OccViewTest, ReadYourOwnWrites) {
+    STM::Var<Big> var(Big(1));
+
+    STM::atomically([&](Transaction& tx) {
+        const Big& before = tx.view(var);
+        tx.store(var, Big(2));
+        EXPECT_EQ(tx.view(var).data[0], 2);
+        // 之前拿到的引用仍指向快照中的旧版本
+        EXPECT_EQ(before.data[0], 1);
+    });
+
+    EXPECT_EQ(var.unsafeLoad().data[0], 2);
+}
+
+// 未合并的增量会被物化成普通写入，随后的 increment 继续叠加
+TEST(OccViewTest, ViewAfterIncrement) {
+    STM::Var<long> counter(10);
+
+    STM::atomically([&](Transaction& tx) {
+        tx.increment(counter, 5L);
+        EXPECT_EQ(tx.view(counter), 15);
+        tx.increment(counter, 1L);
+        EXPECT_EQ(tx.load(counter), 16);
+    });
+
+    EXPECT_EQ(counter.unsafeLoad(), 16);
+}
+
+// 其他事务提交新版本后，已取得的引用仍然指向本事务快照中的值
+TEST(OccViewTest, ReferenceSurvivesConcurrentCommit) {
+    STM::Var<Big> var(Big(7));
+
+    STM::atomically([&](Transaction& tx) {
+        const Big& v = tx.view(var);
+        std::thread([&]() {
+            STM::atomically([&](Transaction& other) { other.store(var, Big(8)); });
+        }).join();
+        EXPECT_EQ(v.sum(), 7L * 512);
+    });
+
+    EXPECT_EQ(var.unsafeLoad().data[0], 8);
+}
+
+// view 同样进入读集：被别人改过的变量导致提交失败
+TEST(OccViewTest, ConflictIsDetected) {
+    STM::Var<Big> var(Big(1));
+    STM::Var<long> out(0);
+
+    TransactionDescriptor desc, desc_other;
+    Transaction tx(&desc);
+    Transaction other(&desc_other);
+
+    tx.begin();
+    long seen = tx.view(var).data[0];
+
+    other.begin();
+    other.store(var, Big(2));
+    EXPECT_TRUE(other.commit());
+
+    tx.store(out, seen);
+    EXPECT_FALSE(tx.commit());
+    EXPECT_EQ(out.unsafeLoad(), 0);
+}
+
+TEST(OccViewTest, ConcurrentReadersSeeConsistentObjects) {
+    STM::Var<Big> var(Big(0));
+    const int kWriters = 2;
+    const int kReaders = 2;
+    const int kOps = 300;
+
+    std::vector<std::thread> workers;
+    for (int w = 0; w < kWriters; ++w) {
+        workers.emplace_back([&]() {
+            for (int i = 0; i < kOps; ++i) {
+                STM::atomically([&](Transaction& tx) {
+                    tx.store(var, Big(tx.view(var).data[0] + 1));
+                });
+            }
+        });
+    }
+    for (int r = 0; r < kReaders; ++r) {
+        workers.emplace_back([&]() {
+            for (int i = 0; i < kOps; ++i) {
+                STM::atomically([&](Transaction& tx) {
+                    const Big& v = tx.view(var);
+                    EXPECT_EQ(v.sum(), v.data[0] * 512);
+                });
+            }
+        });
+    }
+    for (auto& t : workers) t.join();
+
+    EXPECT_EQ(var.unsafeLoad().data[0], kWriters * kOps);
+}
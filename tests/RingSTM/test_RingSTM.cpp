@@ -0,0 +1,216 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include <string>
+#include <memory>
+#include "RingSTM/STM.hpp"
+
+using namespace STM::Ring;
+
+// ==========================================
+// 1. 签名 (Bloom Filter)
+// ==========================================
+TEST(RingSignatureTest, AddAndIntersect) {
+    int a = 0, b = 0;
+
+    CommitRing::Sig rsig;
+    EXPECT_TRUE(rsig.empty());
+    rsig.add(&a);
+    EXPECT_FALSE(rsig.empty());
+
+    CommitRing::Sig wsig;
+    wsig.add(&a);
+
+    STM::Ring::SharedSignature<CommitRing::kSignatureBits> shared;
+    shared.publish(wsig);
+    EXPECT_TRUE(shared.intersects(rsig)) << "Same address must always intersect";
+
+    CommitRing::Sig other;
+    other.add(&b);
+    shared.publish(other);
+    // Bloom Filter 可能误报，但同一个地址绝不能漏报
+    rsig.clear();
+    rsig.add(&b);
+    EXPECT_TRUE(shared.intersects(rsig));
+}
+
+// ==========================================
+// 2. 单线程事务语义
+// ==========================================
+TEST(RingSTMTest, BasicReadWrite) {
+    TMVar<int> account(100);
+
+    STM::Ring::atomically([&](Transaction& tx) {
+        tx.store(account, tx.load(account) + 50);
+    });
+
+    int balance = STM::Ring::atomically([&](Transaction& tx) {
+        return tx.load(account);
+    });
+    EXPECT_EQ(balance, 150);
+}
+
+TEST(RingSTMTest, ReadYourOwnWrites) {
+    TMVar<std::string> name("init");
+    TxDescriptor desc;
+    Transaction tx(&desc);
+
+    tx.begin();
+    EXPECT_EQ(tx.load(name), "init");
+    tx.store(name, std::string("draft"));
+    EXPECT_EQ(tx.load(name), "draft");
+    EXPECT_TRUE(tx.commit());
+
+    EXPECT_EQ(name.loadHead()->payload, "draft");
+}
+
+// 读过的变量被别人提交后，写事务不能再提交
+TEST(RingSTMTest, ConflictingCommitIsRejected) {
+    TMVar<int> x(10);
+    TMVar<int> y(20);
+
+    TxDescriptor desc, desc_other;
+    Transaction tx(&desc);
+    Transaction other(&desc_other);
+
+    tx.begin();
+    EXPECT_EQ(tx.load(x), 10);
+
+    other.begin();
+    other.store(x, 11);
+    EXPECT_TRUE(other.commit());
+
+    tx.store(y, 21);
+    EXPECT_FALSE(tx.commit());
+    EXPECT_EQ(y.loadHead()->payload, 20);
+}
+
+// 之后的读取会立即发现不一致并抛出 RetryException
+TEST(RingSTMTest, ReadAfterConflictingCommitRetries) {
+    TMVar<int> x(1);
+    TMVar<int> y(1);
+
+    TxDescriptor desc, desc_other;
+    Transaction tx(&desc);
+    Transaction other(&desc_other);
+
+    tx.begin();
+    tx.load(x);
+
+    other.begin();
+    other.store(x, 2);
+    other.store(y, 2);
+    EXPECT_TRUE(other.commit());
+
+    EXPECT_THROW(tx.load(y), RetryException);
+    tx.abort();
+}
+
+// 互不相交的提交不影响只读事务
+TEST(RingSTMTest, DisjointCommitDoesNotAbortReader) {
+    TMVar<int> x(1);
+
+    // 签名是 Bloom Filter，挑一个与 x 的比特位不相交的变量，避免误报导致测试不稳定
+    std::vector<std::unique_ptr<TMVar<int>>> candidates;
+    TMVar<int>* z = nullptr;
+    CommitRing::Sig xsig;
+    xsig.add(&x);
+    while (!z) {
+        candidates.push_back(std::make_unique<TMVar<int>>(5));
+        CommitRing::Sig zsig;
+        zsig.add(candidates.back().get());
+        STM::Ring::SharedSignature<CommitRing::kSignatureBits> shared;
+        shared.publish(zsig);
+        if (!shared.intersects(xsig)) z = candidates.back().get();
+    }
+
+    TxDescriptor desc, desc_other;
+    Transaction tx(&desc);
+    Transaction other(&desc_other);
+
+    tx.begin();
+    EXPECT_EQ(tx.load(x), 1);
+
+    other.begin();
+    other.store(*z, 6);
+    EXPECT_TRUE(other.commit());
+
+    // z 是在别人提交之后读到的新值，x 未被修改：快照仍然一致
+    EXPECT_EQ(tx.load(*z), 6);
+    EXPECT_TRUE(tx.commit());
+}
+
+// ==========================================
+// 3. 并发测试
+// ==========================================
+TEST(RingSTMTest, ConcurrentCounter) {
+    TMVar<int> counter(0);
+
+    const int NUM_THREADS = 4;
+    const int INC_PER_THREAD = 1000;
+
+    std::vector<std::thread> workers;
+    for (int i = 0; i < NUM_THREADS; ++i) {
+        workers.emplace_back([&]() {
+            for (int j = 0; j < INC_PER_THREAD; ++j) {
+                STM::Ring::atomically([&](Transaction& tx) {
+                    tx.store(counter, tx.load(counter) + 1);
+                });
+            }
+        });
+    }
+    for (auto& t : workers) t.join();
+
+    int final_val = STM::Ring::atomically([&](Transaction& tx) {
+        return tx.load(counter);
+    });
+    EXPECT_EQ(final_val, NUM_THREADS * INC_PER_THREAD);
+}
+
+// 转账不变量：大读集 + 少量写
+TEST(RingSTMTest, ConcurrentTransfersPreserveTotal) {
+    const int NUM_ACCOUNTS = 64;
+    const int NUM_THREADS = 4;
+    const int OPS_PER_THREAD = 500;
+
+    std::vector<TMVar<int>*> accounts;
+    for (int i = 0; i < NUM_ACCOUNTS; ++i) accounts.push_back(new TMVar<int>(100));
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < NUM_THREADS; ++t) {
+        workers.emplace_back([&, t]() {
+            for (int i = 0; i < OPS_PER_THREAD; ++i) {
+                int from = (t * 7 + i) % NUM_ACCOUNTS;
+                int to = (t * 13 + i * 3 + 1) % NUM_ACCOUNTS;
+                if (from == to) continue;
+
+                STM::Ring::atomically([&](Transaction& tx) {
+                    int a = tx.load(*accounts[from]);
+                    int b = tx.load(*accounts[to]);
+                    tx.store(*accounts[from], a - 1);
+                    tx.store(*accounts[to], b + 1);
+                });
+
+                // 只读审计：读遍所有账户，总额必须恒定
+                if (i % 50 == 0) {
+                    int total = STM::Ring::atomically([&](Transaction& tx) {
+                        int sum = 0;
+                        for (auto* acc : accounts) sum += tx.load(*acc);
+                        return sum;
+                    });
+                    EXPECT_EQ(total, NUM_ACCOUNTS * 100);
+                }
+            }
+        });
+    }
+    for (auto& t : workers) t.join();
+
+    int total = STM::Ring::atomically([&](Transaction& tx) {
+        int sum = 0;
+        for (auto* acc : accounts) sum += tx.load(*acc);
+        return sum;
+    });
+    EXPECT_EQ(total, NUM_ACCOUNTS * 100);
+
+    for (auto* acc : accounts) delete acc;
+}
@@ -7,6 +7,7 @@
 #include <future>
 
 #include "ThreadHeap/ThreadHeap.hpp"
+#include "ThreadHeap/SizeClassPool.hpp"
 #include "common/SizeClassConfig.hpp"
 
 // 辅助函数：填充并检查内存，防止 Use-After-Free 或 Overwrite
@@ -183,4 +184,23 @@ TEST_F(ThreadHeapTest, RandomSizeStress) {
     for (void* p : ptrs) {
         ThreadHeap::deallocate(p);
     }
-}
\ No newline at end of file
+}
+
+// 7. 线程带着存活块退出后，块被别的线程释放：遗弃的 Slab 被之后的线程收养，线程更替不会不断积累 Slab
+TEST_F(ThreadHeapTest, AbandonedSlabsAreAdopted) {
+    const size_t size = 1536;
+    size_t before = SizeClassPool::abandonedSlabCount();
+
+    for (int round = 0; round < 50; ++round) {
+        void* survivor = nullptr;
+        std::thread([&survivor, size]() {
+            survivor = ThreadHeap::allocate(size);
+            CheckMemory(survivor, size);
+        }).join();
+
+        // 远程释放：所属线程已经退出
+        ThreadHeap::deallocate(survivor);
+    }
+
+    EXPECT_LE(SizeClassPool::abandonedSlabCount(), before + 1);
+}
@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "WwSTM/Trace.hpp"
+#include "WwSTM/TxContext.hpp"
+#include "WwSTM/TMVar.hpp"
+
+using namespace STM::Ww;
+
+// 1. 每线程环：按时间合并，线程退出后仍可导出
+TEST(WwTraceTest, RingsAreCollectedAcrossThreads) {
+    trace::clear();
+
+    trace::record(trace::Event::WriteConflict, 0x10, 0x20);
+    std::thread t([]() { trace::record(trace::Event::CommitDone, 0x30); });
+    t.join();
+    trace::record(trace::Event::AbortStolen, 0x40);
+
+    auto records = trace::collect();
+    ASSERT_EQ(records.size(), 3u);
+    EXPECT_EQ(records[0].event, static_cast<uint16_t>(trace::Event::WriteConflict));
+    EXPECT_EQ(records[0].a, 0x10u);
+    EXPECT_EQ(records[0].b, 0x20u);
+    EXPECT_EQ(records[1].event, static_cast<uint16_t>(trace::Event::CommitDone));
+    EXPECT_NE(records[1].thread, records[0].thread);
+    EXPECT_EQ(records[2].thread, records[0].thread);
+
+    trace::clear();
+}
+
+// 写满后只保留最近 kCapacity 条
+TEST(WwTraceTest, RingOverwritesOldest) {
+    trace::clear();
+
+    const uint64_t total = trace::Ring::kCapacity + 10;
+    for (uint64_t i = 0; i < total; ++i) trace::record(trace::Event::ReadStable, i);
+
+    auto records = trace::collect();
+    ASSERT_EQ(records.size(), trace::Ring::kCapacity);
+    EXPECT_EQ(records.front().a, 10u);
+    EXPECT_EQ(records.back().a, total - 1);
+
+    trace::clear();
+}
+
+// 退出线程的环被之后的线程复用，线程不断新建退出时环数不增长
+TEST(WwTraceTest, RingsOfExitedThreadsAreReused) {
+    std::thread([]() { trace::record(trace::Event::CommitDone); }).join();
+    size_t rings = trace::ringCount();
+
+    for (int i = 0; i < 50; ++i) {
+        std::thread([i]() { trace::record(trace::Event::CommitDone, i); }).join();
+    }
+    EXPECT_EQ(trace::ringCount(), rings);
+
+    trace::clear();
+}
+
+// 所属线程写入的同时导出：不会拿到半新半旧的记录
+TEST(WwTraceTest, CollectWhileWriting) {
+    trace::clear();
+
+    std::atomic<bool> stop{false};
+    std::thread writer([&]() {
+        for (uint64_t i = 0; !stop.load(std::memory_order_relaxed); ++i) {
+            trace::record(trace::Event::ReadStable, i, ~i);
+        }
+    });
+
+    for (int round = 0; round < 200; ++round) {
+        auto records = trace::collect();
+        uint64_t last = 0;
+        bool first = true;
+        for (const auto& r : records) {
+            ASSERT_EQ(r.b, ~r.a);
+            if (!first) {
+                ASSERT_EQ(r.a, last + 1);
+            }
+            last = r.a;
+            first = false;
+        }
+    }
+
+    stop = true;
+    writer.join();
+    trace::clear();
+}
+
+// 2. 二进制导出与离线解码
+TEST(WwTraceTest, BinaryRoundTripAndDecoders) {
+    std::vector<trace::Record> records = {
+        {1000, static_cast<uint16_t>(trace::Event::WriteSteal), 0, 0, 0xabc, 0x1},
+        {3500, static_cast<uint16_t>(trace::Event::CommitStart), 0, 1, 0xdef, 42},
+    };
+
+    std::stringstream bin;
+    trace::writeBinary(bin, records);
+
+    std::vector<trace::Record> decoded;
+    ASSERT_TRUE(trace::readBinary(bin, decoded));
+    ASSERT_EQ(decoded.size(), 2u);
+    EXPECT_EQ(decoded[1].ts_ns, 3500u);
+    EXPECT_EQ(decoded[1].b, 42u);
+
+    std::ostringstream text;
+    trace::decodeToText(decoded, text);
+    EXPECT_NE(text.str().find("+0ns [T0] WriteSteal a=0xabc"), std::string::npos);
+    EXPECT_NE(text.str().find("+2500ns [T1] CommitStart a=0xdef b=0x2a"), std::string::npos);
+
+    std::ostringstream json;
+    trace::decodeToChromeJson(decoded, json);
+    EXPECT_NE(json.str().find("\"traceEvents\""), std::string::npos);
+    EXPECT_NE(json.str().find("\"name\":\"CommitStart\""), std::string::npos);
+    EXPECT_NE(json.str().find("\"ts\":2.500"), std::string::npos);
+
+    std::stringstream garbage("not a trace file");
+    EXPECT_FALSE(trace::readBinary(garbage, decoded));
+
+    // 截断的文件：头部声明的记录数远大于实际数据，不能按声明的数量分配
+    std::string truncated = bin.str().substr(0, 8 + sizeof(uint64_t) + sizeof(trace::Record));
+    uint64_t huge = ~uint64_t{0} / 2;
+    truncated.replace(8, sizeof(huge), reinterpret_cast<const char*>(&huge), sizeof(huge));
+    std::stringstream cut(truncated);
+    EXPECT_FALSE(trace::readBinary(cut, decoded));
+    EXPECT_TRUE(decoded.empty());
+}
+
+// 3. 跟踪点只在编译期级别允许时记录
+TEST(WwTraceTest, EngineEventsFollowCompileTimeLevel) {
+    trace::clear();
+    {
+        TMVar<int> var(1);
+        TxContext tx;
+        tx.write(var, tx.read(var) + 1);
+        ASSERT_TRUE(tx.commit());
+    }
+    auto records = trace::collect();
+
+    bool saw_commit = false;
+    bool saw_read = false;
+    for (const auto& r : records) {
+        saw_commit |= r.event == static_cast<uint16_t>(trace::Event::CommitDone);
+        saw_read |= r.event == static_cast<uint16_t>(trace::Event::ReadStable);
+    }
+
+    EXPECT_EQ(saw_commit, trace::kLevel >= trace::kInfo);
+    EXPECT_EQ(saw_read, trace::kLevel >= trace::kDebug);
+    if (trace::kLevel == 0) {
+        EXPECT_TRUE(records.empty());
+    }
+
+    trace::clear();
+}
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include <thread>
 #include <chrono>
+#include <string>
 
 // 包含你的核心头文件
 #include "WwSTM/TxContext.hpp"
@@ -47,6 +48,57 @@ TEST_F(OSTMTest, SingleVarReadWrite) {
     ASSERT_TRUE(tx.commit());
 }
 
+// 测试：view 返回节点内值的地址，语义与 read 一致 (包括读自己的写)
+TEST_F(OSTMTest, ViewMatchesRead) {
+    TMVar<std::string> var(std::string(256, 'a'));
+
+    TxContext tx;
+    const std::string* v = tx.view(var);
+    ASSERT_NE(v, nullptr);
+    ASSERT_EQ(*v, tx.read(var));
+    ASSERT_EQ(v, tx.view(var));
+
+    tx.write(var, std::string("draft"));
+    ASSERT_EQ(*tx.view(var), "draft");
+    ASSERT_EQ(*v, std::string(256, 'a'));
+
+    ASSERT_TRUE(tx.commit());
+}
+
+// 测试：事务已结束时 view 返回 nullptr，不要求 T 可默认构造
+TEST_F(OSTMTest, ViewOnFinishedTransactionIsNull) {
+    struct NoDefault {
+        explicit NoDefault(int v) : value(v) {}
+        int value;
+    };
+    TMVar<NoDefault> var(7);
+
+    TxContext tx;
+    ASSERT_EQ(tx.view(var)->value, 7);
+    ASSERT_TRUE(tx.commit());
+    ASSERT_EQ(tx.view(var), nullptr);
+}
+
+// 测试：右值 write 与 emplace 直接构造进新节点
+TEST_F(OSTMTest, MoveWriteAndEmplace) {
+    TMVar<std::string> var(std::string("init"));
+
+    std::string big(1024, 'y');
+    const char* buffer = big.data();
+
+    TxContext tx;
+    tx.write(var, std::move(big));
+    ASSERT_EQ(tx.view(var)->data(), buffer);
+
+    tx.emplace(var, size_t(3), 'z');
+    ASSERT_EQ(tx.read(var), "zzz");
+    ASSERT_TRUE(tx.commit());
+
+    TxContext check;
+    ASSERT_EQ(check.read(var), "zzz");
+    check.commit();
+}
+
 // 测试：事务提交后的持久性 (Isolation)
 TEST_F(OSTMTest, CommitPersistence) {
     TMVar<int> var(100);
@@ -188,6 +240,106 @@ TEST_F(OSTMTest, WoundWait_YoungDies) {
     tx_final.commit();
 }
 
+// 单字头指针：虚表 + 一个原子字
+TEST_F(OSTMTest, TMVarIsOneTaggedWord) {
+    ASSERT_EQ(sizeof(TMVar<long>), 2 * sizeof(void*));
+}
+
+// 写者持锁期间其他事务读到旧值；写者中止后头指针换回旧节点，之后的写入以旧值为基础
+TEST_F(OSTMTest, AbortRestoresOldNode) {
+    TMVar<int> var(5);
+
+    TxContext* writer = new TxContext();
+    writer->write(var, 50);
+
+    {
+        TxContext reader;
+        ASSERT_EQ(reader.read(var), 5);
+        reader.commit();
+    }
+
+    delete writer;   // 析构即中止
+
+    TxContext tx;
+    tx.write(var, tx.read(var) + 1);
+    ASSERT_TRUE(tx.commit());
+
+    TxContext check;
+    ASSERT_EQ(check.read(var), 6);
+    check.commit();
+}
+
+// =========================================================
+// 5. 有界重试与结束回调
+// =========================================================
+
+TEST_F(OSTMTest, AtomicallyRunsCommitHandlers) {
+    TMVar<int> var(1);
+    int commits = 0;
+
+    TxContext tx;
+    STM::TxOutcome outcome = tx.atomically([&](TxContext& t) {
+        t.onCommit([&]() { commits++; });
+        t.write(var, t.read(var) + 1);
+    });
+
+    ASSERT_EQ(outcome, STM::TxOutcome::Committed);
+    ASSERT_EQ(commits, 1);
+
+    TxContext check;
+    ASSERT_EQ(check.read(var), 2);
+    check.commit();
+}
+
+// 更老的事务一直持有写锁：年轻事务每次都自杀重试，期限到后放弃而不是一直空转
+TEST_F(OSTMTest, AtomicallyTimesOutBehindOlderWriter) {
+    TMVar<int> var(10);
+    TMVar<int> other(0);
+
+    TxContext* holder = new TxContext();
+    holder->write(var, 77);
+
+    // 推进全局时钟，保证后面的事务更年轻
+    {
+        TxContext bump;
+        bump.write(other, 1);
+        ASSERT_TRUE(bump.commit());
+    }
+
+    int aborts = 0;
+    TxContext tx;
+    STM::TxOutcome outcome = tx.atomically([&](TxContext& t) {
+        t.onAbort([&]() { aborts++; });
+        t.write(var, 99);
+    }, STM::TxDeadline::after(std::chrono::milliseconds(20)));
+
+    ASSERT_EQ(outcome, STM::TxOutcome::TimedOut);
+    ASSERT_GE(aborts, 1);
+
+    ASSERT_TRUE(holder->commit());
+    delete holder;
+
+    TxContext check;
+    ASSERT_EQ(check.read(var), 77);
+    check.commit();
+}
+
+TEST_F(OSTMTest, AtomicallyHonoursCancellation) {
+    TMVar<int> var(0);
+    STM::CancellationToken token;
+    token.cancel();
+
+    bool ran = false;
+    TxContext tx;
+    STM::TxOutcome outcome = tx.atomically([&](TxContext& t) {
+        ran = true;
+        t.write(var, 1);
+    }, STM::TxDeadline().cancelledBy(token));
+
+    ASSERT_EQ(outcome, STM::TxOutcome::Cancelled);
+    ASSERT_FALSE(ran);
+}
+
 // main 函数入口
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,37 @@
+// WwSTM 跟踪文件解码器：把 trace::writeBinary 导出的二进制文件转成文本或 Chrome trace JSON
+//
+//   ./build/tools/ww_trace_decode trace.bin            # 文本
+//   ./build/tools/ww_trace_decode --chrome trace.bin > trace.json
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include "WwSTM/Trace.hpp"
+
+int main(int argc, char** argv) {
+    bool chrome = false;
+    const char* path = nullptr;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--chrome") == 0) chrome = true;
+        else path = argv[i];
+    }
+
+    if (!path) {
+        std::cerr << "usage: " << argv[0] << " [--chrome] <trace.bin>\n";
+        return 2;
+    }
+
+    std::ifstream in(path, std::ios::binary);
+    std::vector<STM::Ww::trace::Record> records;
+    if (!in || !STM::Ww::trace::readBinary(in, records)) {
+        std::cerr << "cannot read trace file: " << path << '\n';
+        return 1;
+    }
+
+    if (chrome) STM::Ww::trace::decodeToChromeJson(records, std::cout);
+    else STM::Ww::trace::decodeToText(records, std::cout);
+    return 0;
+}